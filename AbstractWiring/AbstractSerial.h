@@ -12,8 +12,39 @@ enum SerialParity {
     PARITY_EVEN
 };
 
+/* What write() does when the TX buffer is full:
+ *   SERIAL_TX_BLOCK         - wait for the TX ISR to make room (default)
+ *   SERIAL_TX_DROP_NEWEST   - discard the bytes that don't fit
+ *   SERIAL_TX_DROP_OLDEST   - discard the oldest queued bytes to make room
+ *   SERIAL_TX_BLOCK_TIMEOUT - wait, but give up and discard after the timeout (ms) passed to setTxPolicy()
+ * The blocking policies still return early (counting the bytes as dropped) when the peripheral is off or
+ * interrupts are disabled, since the buffer can't drain then.
+ */
+enum SerialTxPolicy {
+    SERIAL_TX_BLOCK = 0,
+    SERIAL_TX_DROP_NEWEST,
+    SERIAL_TX_DROP_OLDEST,
+    SERIAL_TX_BLOCK_TIMEOUT
+};
+
 typedef void(*SERIAL_BREAK_CALLBACK)(void);
 
+/* Driver statistics - only compiled in with SERIAL_ENABLE_STATS defined (project-wide, since it changes the
+ * class layout).  Error counters count received characters flagged by the hardware; a rejected character
+ * (framing/parity error) isn't stored.  High-water marks are the fullest each ring has been, in bytes.
+ */
+#ifdef SERIAL_ENABLE_STATS
+struct SerialStats {
+    unsigned long rx_dropped;     // RX ring full, character discarded
+    unsigned long overrun;        // Hardware RX overrun - a character was lost before the ISR got to it
+    unsigned long framing;
+    unsigned long parity;
+    unsigned long tx_dropped;     // Same as txDropped()
+    unsigned int rx_high_water;
+    unsigned int tx_high_water;
+};
+#endif
+
 class AbstractSerial : public Stream {
     public:
         virtual void begin(unsigned long bitrate) = 0;
@@ -27,7 +58,7 @@ class AbstractSerial : public Stream {
         using Print::write;
         operator bool();
 	void isr_send_char(void); // Utility function used by ISR for TX
-	void isr_get_char(void);  // Utility function used by ISR for RX
+	boolean isr_get_char(void);  // Utility function used by ISR for RX; true = wake CPU (frame completed)
 
         // Extended API - optional - if implemented by subclass, override next function to return true
         #define SERIAL_HAS_EXTENDED_API 1
@@ -39,6 +70,64 @@ class AbstractSerial : public Stream {
         virtual void sendBreak(void) { };
         virtual void attachBreakInterrupt(SERIAL_BREAK_CALLBACK) { };
         virtual void detachBreakInterrupt(void) { };
+
+        /* Framed RX - optional.  With a delimiter set (e.g. '\n'), the driver's RX ISR counts completed frames
+         * and wakes the CPU only when one ends, so the main loop can sleep until a whole line is in.
+         * readFrame() copies one frame without its delimiter and returns its length; a frame longer than the
+         * buffer is truncated and the rest of it discarded.  A frame that fills the driver's RX ring is counted
+         * (and wakes the CPU) as it is cut short; readFrame() returns what was buffered, and the rest of that
+         * frame, plus anything arriving before it was read, is dropped.  Consume data only through readFrame()
+         * while framing is on, or the frame count will run ahead of what's buffered.  setFrameDelimiter(-1)
+         * turns framing off.
+         */
+        #define SERIAL_HAS_FRAME_API 1
+        virtual void setFrameDelimiter(int delim) { };
+        virtual unsigned int framesAvailable(void) { return 0; };
+        virtual size_t readFrame(uint8_t *buf, size_t len) { return 0; };
+
+        /* TX overflow handling - optional.  availableForWrite() is the number of bytes write() will take right
+         * now without blocking or dropping (0 = unknown); txDropped() counts bytes discarded by the policy.
+         */
+        #define SERIAL_HAS_TX_POLICY_API 1
+        virtual void setTxPolicy(enum SerialTxPolicy policy, unsigned long timeout_ms = 0) { };
+        virtual int availableForWrite(void) { return 0; };
+        virtual unsigned long txDropped(boolean reset = false) { return 0; };
+
+        // Statistics - optional, see struct SerialStats.  Returns false if the driver doesn't keep any.
+        #ifdef SERIAL_ENABLE_STATS
+        #define SERIAL_HAS_STATS_API 1
+        virtual boolean getStats(struct SerialStats &stats, boolean reset = false) { return false; };
+        #endif
+
+        /* Zero-copy span API - optional.  Drivers with ring buffers override these to hand out the contiguous
+         * filled (RX) or free (TX) region of their buffers, so protocol code can parse in place or build frames
+         * directly in the TX ring.  Spans may be shorter than what's buffered when the ring wraps; just call again.
+         *
+         * rxPeekSpan() - points p at the oldest unread byte, len = contiguous bytes readable there (0 if none)
+         * rxConsume()  - releases n bytes previously seen through rxPeekSpan()
+         * txReserve()  - points p at free TX space, returns contiguous bytes writable there (<= len, 0 if full)
+         * txCommit()   - queues n bytes written through txReserve() for transmission (clamped to that span)
+         *
+         * The defaults fall back to one-byte spans through peek()/read()/write() so code written against this
+         * API works with any AbstractSerial.
+         */
+        #define SERIAL_HAS_SPAN_API 1
+        virtual void rxPeekSpan(const uint8_t *&p, size_t &len) {
+            int c = peek();
+            if (c < 0) {
+                len = 0;
+                return;
+            }
+            _span_rx = (uint8_t)c;
+            p = &_span_rx;
+            len = 1;
+        };
+        virtual void rxConsume(size_t n) { while (n--) read(); };
+        virtual size_t txReserve(uint8_t *&p, size_t len) { p = &_span_tx; return (len ? 1 : 0); };
+        virtual void txCommit(size_t n) { if (n) write(_span_tx); };
+
+    private:
+        uint8_t _span_rx, _span_tx;  // Staging for the default one-byte spans
 };
 
 #endif /* ABSTRACTSERIAL_H_INCLUDED */
@@ -63,6 +63,9 @@ typedef uint16_t word;
  *   uint16_t analogRead(int);
  *   void analogWrite(int, int);
  *   void analogReference(int);
+ * function prototypes for direct output port access (optional; required by SPIDevice)
+ *   volatile uint8_t * portOutputRegister(int pin);
+ *   uint8_t digitalPinToBitMask(int pin);
  * function prototypes for delay, delayMicroseconds, optionally sleep, suspend, wakeup
  *   void delay(uint32_t milliseconds);
  *   void delayMicroseconds(uint16_t us);
@@ -0,0 +1,98 @@
+/* AbstractWiring RingBuffer - lock-free single-producer/single-consumer FIFO for ISR <-> mainline data exchange. */
+
+#ifndef RINGBUFFER_H_INCLUDED
+#define RINGBUFFER_H_INCLUDED
+
+#include <AbstractWiring.h>
+
+/* The size must be a power of two so index wrap-around is a bitmask rather than a modulo; on CPUs without
+ * a hardware divider (e.g. MSP430G2) every % on a buffer index otherwise costs a software division.
+ *
+ * _head and _tail are free-running counters that are only masked when indexing the storage array, so all
+ * N slots are usable and the fill level is simply (_head - _tail) in unsigned arithmetic.
+ *
+ * Lock-free rules: the producer (e.g. the RX ISR, or write()) only ever modifies _head and the consumer
+ * (e.g. read(), or the TX ISR) only ever modifies _tail.  Each side stores the element before publishing
+ * its new index, so the other side never sees a slot which isn't ready.  This relies on unsigned int
+ * loads/stores being atomic, which holds on MSP430 (16-bit) and RX (32-bit).
+ */
+template <typename T, size_t N>
+class RingBuffer {
+    static_assert(N >= 2 && (N & (N - 1)) == 0, "RingBuffer size must be a power of two");
+    static_assert(N <= ((unsigned int)~0U >> 1) + 1U, "RingBuffer size too large for free-running unsigned int indices");
+
+    private:
+        volatile T _buf[N];
+        volatile unsigned int _head, _tail;
+
+        static const unsigned int _mask = N - 1;
+
+    public:
+        RingBuffer() : _head(0), _tail(0) { };
+
+        // Not lock-free; only call while the ISR side of the buffer is quiesced.
+        void clear(void) { _head = 0; _tail = 0; };
+
+        unsigned int available(void) const { return _head - _tail; };
+        unsigned int availableForWrite(void) const { return N - (_head - _tail); };
+        boolean isEmpty(void) const { return _head == _tail; };
+        boolean isFull(void) const { return (_head - _tail) == N; };
+
+        // Producer side - returns false (and drops the element) if the buffer is full
+        boolean push(T c) {
+            unsigned int h = _head;
+            if ((h - _tail) == N)
+                return false;
+            _buf[h & _mask] = c;
+            _head = h + 1;
+            return true;
+        };
+
+        // Consumer side - caller must check isEmpty() first
+        T peek(void) const { return _buf[_tail & _mask]; };
+
+        // i-th oldest element, for a consumer that reads ahead before it pops; caller must check available() > i
+        T peek(unsigned int i) const { return _buf[(_tail + i) & _mask]; };
+
+        T pop(void) {
+            unsigned int t = _tail;
+            T c = _buf[t & _mask];
+            _tail = t + 1;
+            return c;
+        };
+
+        /* Bulk access - the free (or filled) area of the ring is at most two contiguous regions, split where
+         * the storage array wraps.  writeSpan()/readSpan() return the first region and its length; once the
+         * caller has copied into/out of it, commit()/consume() publishes the new index to the other side.
+         * The compiler barrier keeps non-volatile copies (e.g. memcpy) ordered before the index update.
+         */
+        unsigned int writeSpan(T *& p) {
+            unsigned int h = _head;
+            unsigned int room = N - (h - _tail);
+            unsigned int contig = N - (h & _mask);
+
+            p = (T *)&_buf[h & _mask];
+            return (room < contig ? room : contig);
+        };
+
+        void commit(unsigned int n) {
+            __asm__ __volatile__ ("" ::: "memory");
+            _head = _head + n;
+        };
+
+        unsigned int readSpan(const T *& p) const {
+            unsigned int t = _tail;
+            unsigned int used = _head - t;
+            unsigned int contig = N - (t & _mask);
+
+            p = (const T *)&_buf[t & _mask];
+            return (used < contig ? used : contig);
+        };
+
+        void consume(unsigned int n) {
+            __asm__ __volatile__ ("" ::: "memory");
+            _tail = _tail + n;
+        };
+};
+
+#endif /* RINGBUFFER_H_INCLUDED */
@@ -11,6 +11,11 @@
  * #define SPI_HAS_TRANSACTION_SEMAPHORE 1
  * #define SPI_HAS_TRANSFER16 1
  * #define SPI_HAS_TRANSFER9 1
+ * #define SPI_HAS_TRANSFER_BUFFER 1
+ * #define SPI_HAS_TRANSFER_ASYNC 1
+ * #define SPI_HAS_RELEASE_TRANSACTION 1
+ * #define SPI_HAS_STREAM 1
+ * #define SPI_HAS_DEFERRED_TRANSACTION 1
  *
  * All implementations must provide transfer16(), transfer9(), beginTransaction(), endTransaction(), attachInterrupt(), detachInterrupt(),
  * usingInterrupt() but do not necessarily need any code in those functions.
@@ -27,6 +32,13 @@
 #define SPI_MODE_2 SPI_MODE2
 #define SPI_MODE_3 SPI_MODE3
 
+typedef void(*SPI_ASYNC_CALLBACK)(void *arg);
+typedef boolean(*SPI_STREAM_CALLBACK)(void *arg, uint8_t half);
+typedef void(*SPI_TRANSACTION_CALLBACK)(void *arg);
+
+// SPISettings::_image value meaning "not computed yet"
+#define SPI_SETTINGS_NO_IMAGE 0xFFFFFFFFUL
+
 // SPISettings is required for transaction support, but your implementation of SPIClass can use it or ignore it.
 class SPISettings {
     public:
@@ -34,22 +46,23 @@ class SPISettings {
         uint8_t _bitorder;
         uint8_t _datamode;
 
-        SPISettings(uint32_t clockrate, uint8_t bitorder, uint8_t datamode) {
-            _clock = clockrate;
-            _bitorder = bitorder;
-            _datamode = datamode;
-        };
+        /* Register image - the hardware settings this SPIClass implementation derives from the fields above,
+         * packed however it likes, so beginTransaction() only has to store them.  Filled in by the first
+         * beginTransaction() that uses this object (mutable, as that takes a const reference), or up front by
+         * the implementation's constexpr helper.  Don't modify the fields above afterwards; use a new object.
+         */
+        mutable uint32_t _image;
 
-        SPISettings() {
-            _clock = 4000000UL;
-            _bitorder = MSBFIRST;
-            _datamode = SPI_MODE0;
-        };
+        constexpr SPISettings(uint32_t clockrate, uint8_t bitorder, uint8_t datamode, uint32_t image = SPI_SETTINGS_NO_IMAGE)
+            : _clock(clockrate), _bitorder(bitorder), _datamode(datamode), _image(image) { };
 
-        void copy(SPISettings s) {
+        constexpr SPISettings() : _clock(4000000UL), _bitorder(MSBFIRST), _datamode(SPI_MODE0), _image(SPI_SETTINGS_NO_IMAGE) { };
+
+        void copy(const SPISettings & s) {
             _clock = s._clock;
             _bitorder = s._bitorder;
             _datamode = s._datamode;
+            _image = s._image;
         };
 };
 
@@ -64,9 +77,89 @@ class SPIClass {
         virtual void setClockDivider(int clockDiv) = 0;
         virtual void attachInterrupt() { };  // This doesn't do anything in Arduino anyhow
         virtual void detachInterrupt() { };  // This doesn't do anything in Arduino anyhow
-        virtual boolean beginTransaction(SPISettings settings) = 0;
+        virtual boolean beginTransaction(const SPISettings & settings) = 0;
         virtual void endTransaction(void) = 0;
         virtual void usingInterrupt(int pin) = 0;
+        virtual void notUsingInterrupt(int pin) { };
+
+        /* releaseTransaction() ends a transaction like endTransaction() but leaves its settings loaded, so a
+         * following beginTransaction() with the same settings (e.g. the same SPIDevice again) skips the
+         * register writes.  The settings in effect outside transactions are restored by the next
+         * endTransaction(); don't use the bus outside transactions in between.  The default just ends it.
+         */
+        virtual void releaseTransaction(void) { endTransaction(); };
+
+        /* requestTransaction() runs callback(arg) inside a transaction with settings - right away if the bus is
+         * free, otherwise queued and run as soon as the current transaction ends (higher priority first, in
+         * order within a priority), in whichever context ends it.  Meant for ISRs that can't wait for the bus;
+         * settings is copied, so a temporary will do.  False if the bus is busy and the queue full.
+         * maskedMicros() is the longest time a transaction has held the usingInterrupt() interrupts masked,
+         * i.e. the worst-case latency it added to them.
+         * The defaults can't queue: they run the callback if the bus is free and report no masking.
+         */
+        virtual boolean requestTransaction(const SPISettings & settings, SPI_TRANSACTION_CALLBACK callback, void *arg = NULL, uint8_t priority = 0) {
+            if (!beginTransaction(settings))
+                return false;
+            callback(arg);
+            endTransaction();
+            return true;
+        };
+        virtual unsigned long maskedMicros(boolean reset = false) { return 0; };
+
+        /* Buffer API - transfer(buf, n) exchanges buf in place; transfer(tx, rx, n) sends tx and stores the
+         * reply in rx (tx == NULL sends 0xFF, rx == NULL discards it); write() is TX-only.  The defaults go
+         * byte by byte through transfer(uint8_t); implementations override them with a pipelined loop.
+         */
+        virtual void transfer(void *buf, size_t n) {
+            uint8_t *p = (uint8_t *)buf;
+            while (n--) {
+                *p = transfer(*p);
+                p++;
+            }
+        };
+        virtual void transfer(const void *tx, void *rx, size_t n) {
+            const uint8_t *t = (const uint8_t *)tx;
+            uint8_t *r = (uint8_t *)rx;
+            while (n--) {
+                uint8_t c = transfer(t ? *t++ : 0xFF);
+                if (r)
+                    *r++ = c;
+            }
+        };
+        virtual void write(const void *buf, size_t n) { transfer(buf, NULL, n); };
+
+        /* Asynchronous API - transferAsync() queues a buffer transfer (same tx/rx rules as above) and returns
+         * at once, or returns false if the queue is full.  The buffers must stay valid until the callback,
+         * which runs in interrupt context with `arg' once that transfer completes; queued transfers run back
+         * to back.  isBusy() is true while anything is queued and wait() blocks until the queue is empty.
+         * Don't mix blocking transfers in while isBusy().  The defaults just run the transfer synchronously.
+         */
+        virtual boolean transferAsync(const void *tx, void *rx, size_t n, SPI_ASYNC_CALLBACK callback = NULL, void *arg = NULL) {
+            transfer(tx, rx, n);
+            if (callback != NULL)
+                callback(arg);
+            return true;
+        };
+        virtual boolean isBusy(void) { return false; };
+        virtual void wait(void) { };
+
+        /* Streaming API - continuous full-duplex exchange through ping-pong buffers: tx and rx (either may be
+         * NULL, as above) each hold two halves of half_size bytes which the interrupt-driven engine cycles
+         * through for as long as the stream runs.  After each half it calls callback(arg, half) in interrupt
+         * context; returning true hands the half straight back (refilled/drained already), false keeps it
+         * until streamRelease(half).  Reaching a half the application still holds counts an underrun and
+         * clocks it anyway - the rate never bends.  With frame_size 0 bytes run back to back; otherwise each
+         * streamTick() (e.g. from a timer ISR at the sample rate) starts one frame of frame_size bytes, which
+         * must divide half_size; overruns count ticks that came while the previous frame was still shifting.
+         * Nothing else may use the bus until endStream().
+         * The defaults report streaming as unsupported.
+         */
+        virtual boolean beginStream(const void *tx, void *rx, size_t half_size, SPI_STREAM_CALLBACK callback, void *arg = NULL, size_t frame_size = 0) { return false; };
+        virtual void streamTick(void) { };
+        virtual void streamRelease(uint8_t half) { };
+        virtual void endStream(void) { };
+        virtual unsigned long streamUnderruns(boolean reset = false) { return 0; };
+        virtual unsigned long streamOverruns(boolean reset = false) { return 0; };
 
         // Extended API - optional - if implemented by subclass, override next function to return true
 #define SPI_HAS_EXTENDED_API 1
@@ -74,6 +167,12 @@ class SPIClass {
 
         virtual uint16_t transfer16(uint16_t) { return 0; };
         virtual uint16_t transfer9(uint16_t) { return 0; };
+
+        // Write-only stream of 9-bit words (e.g. a 3-wire LCD); the default goes word by word
+        virtual void transfer9(const uint16_t *words, size_t n) {
+            while (n--)
+                transfer9(*words++);
+        };
 };
 
 #endif /* SPI_H_INCLUDED */
@@ -0,0 +1,84 @@
+/* AbstractWiring SPIDevice - one chip on a shared SPIClass bus, with its own settings, chip select and IRQ pin. */
+
+#ifndef SPIDEVICE_H_INCLUDED
+#define SPIDEVICE_H_INCLUDED
+
+#include <AbstractWiring.h>
+#include <SPI.h>
+
+/* select() opens a transaction with the device's settings and pulls CS low; deselect() raises CS and ends the
+ * transaction with releaseTransaction(), leaving the device's settings loaded so that back-to-back transactions
+ * to the same device skip reconfiguring the bus.  The settings are copied in, so their register image is
+ * computed once per device rather than once per transaction.
+ *
+ * CS is resolved to a port register and bit mask in begin() (platform.h portOutputRegister()/digitalPinToBitMask())
+ * and from then on driven with direct writes.  Pass a negative cs_pin to drive CS yourself.  An IRQ pin, if
+ * given (> 0), is handed to the bus' usingInterrupt() so its handler is held off during transactions.
+ *
+ *   SPIDevice flash(SPI, P2_0, usci_spi_settings(8000000UL, MSBFIRST, SPI_MODE0));
+ *
+ *   flash.begin();
+ *   if (flash.select()) {
+ *       flash.transfer(0x9F);  // JEDEC ID
+ *       flash.transfer(NULL, id, 3);
+ *       flash.deselect();
+ *   }
+ */
+class SPIDevice {
+    private:
+        SPIClass & _spi;
+        SPISettings _settings;
+        volatile uint8_t *_cs_out;
+        uint8_t _cs_mask;
+        uint8_t _cs_none;  // Stand-in port for a device without a CS pin
+        int _cs_pin, _irq_pin;
+
+    public:
+        SPIDevice(SPIClass & spi, int cs_pin, const SPISettings & settings, int irq_pin = 0) :
+            _spi(spi), _settings(settings), _cs_out(&_cs_none), _cs_mask(0), _cs_pin(cs_pin), _irq_pin(irq_pin) { };
+
+        // Call after the platform is up (e.g. after sysinit()); drives CS high
+        void begin(void) {
+            volatile uint8_t *port = (_cs_pin >= 0) ? portOutputRegister(_cs_pin) : NULL;
+
+            if (port != NULL) {
+                _cs_out = port;
+                _cs_mask = digitalPinToBitMask(_cs_pin);
+                *_cs_out |= _cs_mask;
+                pinMode(_cs_pin, OUTPUT);
+            }
+            if (_irq_pin > 0)
+                _spi.usingInterrupt(_irq_pin);
+        };
+
+        // Replaces the device's settings; the bus reloads them at the next select()
+        void setSettings(const SPISettings & settings) { _settings.copy(settings); };
+
+        // False if the bus is already in a transaction (e.g. one opened by an interrupted mainline)
+        boolean select(void) {
+            if (!_spi.beginTransaction(_settings))
+                return false;
+            *_cs_out &= ~_cs_mask;
+            return true;
+        };
+
+        void deselect(void) {
+            _spi.wait();  // CS must stay low until any asynchronous transfer is out
+            *_cs_out |= _cs_mask;
+            _spi.releaseTransaction();
+        };
+
+        SPIClass & bus(void) { return _spi; };
+
+        // Data transfer - only between select() and deselect()
+        uint8_t transfer(uint8_t c) { return _spi.transfer(c); };
+        uint16_t transfer16(uint16_t w) { return _spi.transfer16(w); };
+        void transfer(void *buf, size_t n) { _spi.transfer(buf, n); };
+        void transfer(const void *tx, void *rx, size_t n) { _spi.transfer(tx, rx, n); };
+        void write(const void *buf, size_t n) { _spi.write(buf, n); };
+        boolean transferAsync(const void *tx, void *rx, size_t n, SPI_ASYNC_CALLBACK callback = NULL, void *arg = NULL) {
+            return _spi.transferAsync(tx, rx, n, callback, arg);
+        };
+};
+
+#endif /* SPIDEVICE_H_INCLUDED */
@@ -0,0 +1,100 @@
+/* AbstractWiring SPIStream - ping-pong buffer bookkeeping shared by the SPIClass streaming implementations. */
+
+#ifndef SPISTREAM_H_INCLUDED
+#define SPISTREAM_H_INCLUDED
+
+#include <AbstractWiring.h>
+#include <SPI.h>
+
+/* The driver's ISR calls nextTx() for the byte it's about to send and received() with the byte that came
+ * back; everything else - positions, half and frame boundaries, callbacks, ownership of the halves and the
+ * counters - lives here.  Only the ISR side moves the position; the application only ever clears the
+ * ownership flags (release()), and each flag is a separate byte so neither side needs a read-modify-write.
+ * Countdowns instead of % keep divisions out of the ISR.
+ */
+class SPIStream {
+    private:
+        const uint8_t *_tx;
+        uint8_t *_rx;
+        size_t _half, _frame;
+        size_t _pos, _half_left, _frame_left;
+        SPI_STREAM_CALLBACK _callback;
+        void *_arg;
+        volatile boolean _held[2];  // Half is owned by the application until release()
+        volatile boolean _active, _frame_busy;
+        volatile unsigned long _underruns, _overruns;
+
+    public:
+        SPIStream() : _active(false), _underruns(0), _overruns(0) { };
+
+        void start(const void *tx, void *rx, size_t half_size, SPI_STREAM_CALLBACK callback, void *arg, size_t frame_size) {
+            _tx = (const uint8_t *)tx;
+            _rx = (uint8_t *)rx;
+            _half = half_size;
+            _frame = frame_size;
+            _pos = 0;
+            _half_left = half_size;
+            _frame_left = frame_size;
+            _callback = callback;
+            _arg = arg;
+            _held[0] = false;
+            _held[1] = false;
+            _frame_busy = (frame_size == 0);  // Free-running streams are always mid-frame
+            _active = true;
+        };
+
+        void stop(void) { _active = false; };
+        boolean active(void) const { return _active; };
+        boolean paced(void) const { return _frame != 0; };
+
+        uint8_t nextTx(void) const { return (_tx != NULL) ? _tx[_pos] : 0xFF; };
+
+        /* Stores the byte exchanged at the current position and moves on.  Returns true if the next byte
+         * should be sent right away, false at the end of a paced frame; half_done is set when a half has just
+         * been handed to the application.
+         */
+        boolean received(uint8_t c, boolean & half_done) {
+            if (_rx != NULL)
+                _rx[_pos] = c;
+            _pos++;
+            half_done = false;
+            if (--_half_left == 0) {
+                uint8_t h = (_pos == _half) ? 0 : 1;
+                _half_left = _half;
+                if (h)
+                    _pos = 0;
+                if (_callback != NULL && !_callback(_arg, h))
+                    _held[h] = true;
+                if (_held[h ^ 1])
+                    _underruns++;  // The application still has the half we're about to clock
+                half_done = true;
+            }
+            if (_frame && --_frame_left == 0) {
+                _frame_left = _frame;
+                _frame_busy = false;
+                return false;
+            }
+            return true;
+        };
+
+        /* Paced streams - true if a new frame may start now; a tick while one is still shifting is lost.
+         * Free-running or stopped streams ignore ticks; they neither start a frame nor count an overrun.
+         */
+        boolean tick(void) {
+            if (!_active || !_frame)
+                return false;
+            if (_frame_busy) {
+                _overruns++;
+                return false;
+            }
+            _frame_busy = true;
+            return true;
+        };
+
+        void release(uint8_t half) { _held[half & 1] = false; };
+
+        unsigned long underruns(boolean reset) { unsigned long n = _underruns; if (reset) _underruns = 0; return n; };
+        unsigned long overruns(boolean reset) { unsigned long n = _overruns; if (reset) _overruns = 0; return n; };
+};
+
+#endif /* SPISTREAM_H_INCLUDED */
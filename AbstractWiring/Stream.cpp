@@ -218,10 +218,15 @@ size_t Stream::readBytes(char *buffer, size_t length)
 {
   size_t count = 0;
   while (count < length) {
+    size_t n = readBuffered((uint8_t *)buffer + count, length - count);
+    if (n) {
+      count += n;
+      continue;
+    }
+    // buffer ran dry, only now does the timeout clock matter
     int c = timedRead();
     if (c < 0) break;
-    *buffer++ = (char)c;
-    count++;
+    buffer[count++] = (char)c;
   }
   return count;
 }
@@ -235,15 +240,35 @@ size_t Stream::readBytesUntil(char terminator, char *buffer, size_t length)
 {
   if (length < 1) return 0;
   size_t index = 0;
+  uint8_t term = (uint8_t)terminator;
   while (index < length) {
+    size_t n = readBuffered((uint8_t *)buffer + index, length - index, term);
+    if (n) {
+      index += n;
+      if ((uint8_t)buffer[index - 1] == term)
+        return index - 1;  // terminator is consumed but not counted
+      continue;
+    }
     int c = timedRead();
-    if (c < 0 || c == terminator) break;
-    *buffer++ = (char)c;
-    index++;
+    if (c < 0 || c == term) break;
+    buffer[index++] = (char)c;
   }
   return index; // return number of characters, not including null terminator
 }
 
+// default bulk-read hook, for streams without a buffer of their own to block-copy from
+size_t Stream::readBuffered(uint8_t *buffer, size_t length, int terminator)
+{
+  size_t count = 0;
+  while (count < length && available() > 0) {
+    int c = read();
+    if (c < 0) break;
+    buffer[count++] = (uint8_t)c;
+    if (c == terminator) break;
+  }
+  return count;
+}
+
 String Stream::readString()
 {
   String ret;
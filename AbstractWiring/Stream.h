@@ -81,6 +81,12 @@ class Stream : public Print
   // terminates if length characters have been read, timeout, or if the terminator character  detected
   // returns the number of characters placed in the buffer (0 means no valid data found)
 
+  virtual size_t readBuffered(uint8_t *buffer, size_t length, int terminator = -1); // bulk-read hook
+  // copies up to length characters which are already buffered, never waits; if terminator >= 0 the copy
+  // stops right after the first terminator, which is placed in the buffer too
+  // returns the number of characters consumed from the stream
+  // the default uses available()/read(), drivers with their own buffer should override it with a block copy
+
   // Arduino String functions to be added here
   String readString();
   String readStringUntil(char terminator);
@@ -11,6 +11,29 @@
 typedef void(*TWOWIRE_SLAVE_TX_CALLBACK)(void);
 typedef void(*TWOWIRE_SLAVE_RX_CALLBACK)(size_t);
 
+/* Asynchronous transaction descriptor, owned by the application - a write (rxlen 0), a read (txlen 0) or a
+ * write-then-read with a repeated START in between.  Everything but status and next is set by the caller;
+ * the descriptor and both buffers must stay untouched until status leaves TWOWIRE_PENDING.
+ */
+#define TWOWIRE_PENDING (-1)
+#define TWOWIRE_OK 0  // Any other status is a failure; implementations define their own codes
+
+struct twowire_transaction;
+typedef void(*TWOWIRE_ASYNC_CALLBACK)(struct twowire_transaction *t);
+
+struct twowire_transaction {
+    int addr;
+    const uint8_t *tx;
+    size_t txlen;
+    uint8_t *rx;
+    size_t rxlen;
+    uint16_t timeout_ms;              // START/address phase timeout; 0 = the driver's default
+    TWOWIRE_ASYNC_CALLBACK callback;  // Optional; runs in interrupt context and may queue t again
+    void *arg;                        // For the callback's use
+    volatile int8_t status;
+    struct twowire_transaction *next; // Driver use
+};
+
 class TwoWire : public Stream {
     public:
         virtual void begin(void) = 0;
@@ -21,11 +44,55 @@ class TwoWire : public Stream {
 
         virtual void beginTransmission(uint8_t) = 0;
         virtual void beginTransmission(int addr) { beginTransmission((uint8_t)addr); };  // Override for >8-bit I2C addresses
-        virtual boolean endTransmission(void);
+        virtual boolean endTransmission(void) = 0;
+
+        /* stop = false leaves the bus held after the write, so the next endTransmission()/requestFrom() starts
+         * with a repeated START - e.g. a register address write followed by the read.  The default always stops.
+         */
+        virtual boolean endTransmission(boolean stop) { return endTransmission(); };
 
         virtual uint8_t requestFrom(uint8_t addr, uint8_t len) = 0;
         virtual int requestFrom(int addr, int len) { return requestFrom((uint8_t)addr, (uint8_t)len); };  // Override for >8-bit I2C addresses
 
+        /* Reads len bytes straight into dst, bypassing the receive buffer (available() stays 0); 0 on failure.
+         * timeout_ms bounds the START/address phase, 0 = the driver's default; the defaults ignore it.
+         */
+        virtual size_t requestFrom(int addr, uint8_t *dst, size_t len, uint16_t timeout_ms = 0) { return writeThenRead(addr, NULL, 0, dst, len, timeout_ms) ? len : 0; };
+
+        /* Combined transaction - writes txlen bytes from tx, then reads rxlen bytes straight into rx after a
+         * repeated START, then STOP.  Either length may be 0.  False on NACK or bus errors.  timeout_ms as above.
+         */
+        virtual boolean writeThenRead(int addr, const uint8_t *tx, size_t txlen, uint8_t *rx, size_t rxlen, uint16_t timeout_ms = 0) {
+            size_t x;
+
+            if (txlen) {
+                beginTransmission(addr);
+                if (write(tx, txlen) != txlen || !endTransmission(rxlen == 0))
+                    return false;
+            }
+            if (rxlen) {
+                if ((size_t)requestFrom(addr, (int)rxlen) != rxlen)
+                    return false;
+                for (x = 0; x < rxlen; x++)
+                    rx[x] = read();
+            }
+            return true;
+        };
+
+        /* Asynchronous API - queueTransaction() appends t to the queue and returns at once; queued
+         * transactions run back to back, each completing by setting t->status and calling t->callback.
+         * isBusy() is true while anything is queued and wait() blocks until the queue is empty.  The blocking
+         * calls above wait for the queue first.  The defaults just run the transaction synchronously.
+         */
+        virtual boolean queueTransaction(struct twowire_transaction *t) {
+            t->status = writeThenRead(t->addr, t->tx, t->txlen, t->rx, t->rxlen, t->timeout_ms) ? TWOWIRE_OK : 1;
+            if (t->callback != NULL)
+                t->callback(t);
+            return true;
+        };
+        virtual boolean isBusy(void) { return false; };
+        virtual void wait(void) { };
+
         virtual size_t write(uint8_t) = 0;
         virtual size_t write(const uint8_t *buf, size_t len) {
             size_t x = 0;
@@ -5,10 +5,71 @@
 
 #include <AbstractWiring.h>
 #include <SPI.h>
+#include <SPIStream.h>
+#include <SPI_USCI_EXTISR.h>
+#include <SPI_USCI_Pack9.h>
+#include <usci_isr.h>
+
+// Depth of the transferAsync() queue; must be a power of two
+#ifndef SPI_USCI_ASYNC_QUEUE_LEN
+#define SPI_USCI_ASYNC_QUEUE_LEN 4
+#endif
+
+// Depth of the requestTransaction() queue
+#ifndef SPI_USCI_DEFERRED_QUEUE_LEN
+#define SPI_USCI_DEFERRED_QUEUE_LEN 4
+#endif
+
+struct spi_usci_deferred_transaction {
+    SPISettings settings;  // A copy, so callers may pass a temporary such as usci_spi_settings(...)
+    SPI_TRANSACTION_CALLBACK callback;
+    void *arg;
+    uint8_t priority;
+};
+
+struct spi_usci_async_job {
+    const uint8_t *tx;
+    uint8_t *rx;
+    size_t n;
+    SPI_ASYNC_CALLBACK callback;
+    void *arg;
+};
 
-static const uint8_t _usci_spi_mode_bits[] = { UCCKPH, 0, (UCCKPL | UCCKPH), UCCKPL };
+/* Register image (see SPISettings::_image) - UCxCTL0 in bits 0-7 and UCxBR0/UCxBR1 in bits 8-23, with
+ * BRCLK = SMCLK = F_CPU.  All constexpr, so constant settings can be resolved at compile time:
+ *
+ *   const SPISettings lcd = usci_spi_settings(8000000UL, MSBFIRST, SPI_MODE0);
+ */
+constexpr uint8_t usci_spi_mode_bits(uint8_t datamode)
+{
+    return (datamode == SPI_MODE0) ? UCCKPH :
+           (datamode == SPI_MODE1) ? 0 :
+           (datamode == SPI_MODE2) ? (UCCKPL | UCCKPH) : UCCKPL;
+}
+
+/* Rounds up, since a partial division would leave us with a divider that produces too fast a clock.
+ * Also this will always give /1 if brclk < bitrate.
+ */
+constexpr uint16_t usci_spi_clkdiv(uint32_t brclk, uint32_t bitrate)
+{
+    return (uint16_t)(brclk / bitrate + ((brclk % bitrate) ? 1 : 0));
+}
+
+constexpr uint32_t usci_spi_image(uint32_t clock, uint8_t bitorder, uint8_t datamode)
+{
+    return (uint32_t)(UCMST | UCSYNC | (bitorder == MSBFIRST ? UCMSB : 0) | usci_spi_mode_bits(datamode))
+         | ((uint32_t)usci_spi_clkdiv(F_CPU, clock) << 8);
+}
+
+constexpr SPISettings usci_spi_settings(uint32_t clock, uint8_t bitorder, uint8_t datamode)
+{
+    return SPISettings(clock, bitorder, datamode, usci_spi_image(clock, bitorder, datamode));
+}
+
+static const uint8_t _usci_spi_fill = 0xFF;  // TX byte when the buffer API is given tx == NULL
 
 template <
+    enum USCI_SPI_Instance usci_spi_instance,
     u8_SFR ucxctl0,
     u8_SFR ucxctl1,
     u8_SFR ucxbr0,
@@ -16,6 +77,11 @@ template <
     u8_SFR ucxstat,
     u8_SFR ucxtxbuf,
     u8_CSFR ucxrxbuf,
+    u8_SFR ucxifg,
+    uint8_t ucxtxifg,
+    uint8_t ucxrxifg,
+    u8_SFR ucxie,
+    uint8_t ucxrxie,
     u8_SFR sclk_pxdir,  // The pxdir, pxout, pxin's are all needed for 9-bit mode
     u8_SFR sclk_pxout,
     u8_SFR sclk_pxsel,
@@ -35,17 +101,43 @@ template <
     const uint8_t miso_pxbits,
     enum PortselMode miso_pxsel_specification >
 
-class SPI_USCI : public SPIClass {
+class SPI_USCI : public SPI_USCI_EXTISR {
+    static_assert((SPI_USCI_ASYNC_QUEUE_LEN & (SPI_USCI_ASYNC_QUEUE_LEN - 1)) == 0, "SPI_USCI_ASYNC_QUEUE_LEN must be a power of two");
+
     private:
         SPISettings _settings, _settings_old;
-        int _mask_irq;
-        boolean _transaction_semaphore;
+        uint16_t _mask_pins;  // usingInterrupt() pins, bit (pin - 1)
+        unsigned long _mask_start, _mask_max;
+        volatile boolean _transaction_semaphore;
+        boolean _transaction_released;  // Last transaction ended by releaseTransaction(); hardware still holds _settings
+
+        // transferAsync() queue - mainline adds at _job_head, the RX ISR retires jobs at _job_tail
+        struct spi_usci_async_job _jobs[SPI_USCI_ASYNC_QUEUE_LEN];
+        volatile unsigned int _job_head, _job_tail;
+        size_t _job_pos;  // Bytes of the job at _job_tail clocked so far
+        boolean _job_in_callback;  // The ISR is running a job callback and will start whatever it queues
+        SPIStream _stream;
+
+        // requestTransaction() queue, highest priority first; only touched with GIE off
+        struct spi_usci_deferred_transaction _deferred[SPI_USCI_DEFERRED_QUEUE_LEN];
+        uint8_t _deferred_count;
+        boolean _deferred_running;
+
+        static uint8_t _job_byte(struct spi_usci_async_job *j, size_t i) { return j->tx ? j->tx[i] : _usci_spi_fill; };
+
+        // Image of s, computing and caching it on first use - the only place the clock division happens
+        static uint32_t _image_of(const SPISettings & s) {
+            if (s._image == SPI_SETTINGS_NO_IMAGE)
+                s._image = usci_spi_image(s._clock, s._bitorder, s._datamode);
+            return s._image;
+        };
 
-        uint8_t _derive_ctl0_bits(SPISettings & s) {
-            uint8_t mode = _usci_spi_mode_bits[s._datamode];
-            uint8_t msb = (s._bitorder == MSBFIRST ? UCMSB : 0);
-            return UCMST | msb | mode;
-        }
+        // Caller must hold UCSWRST
+        void _load_image(uint32_t image) {
+            ucxctl0 = (uint8_t)image;
+            ucxbr0 = (uint8_t)(image >> 8);
+            ucxbr1 = (uint8_t)(image >> 16);
+        };
 
 #ifdef SPI_ENABLE_EXTENDED_API
         NEVER_INLINE
@@ -98,11 +190,20 @@ class SPI_USCI : public SPIClass {
 #endif /* SPI_ENABLE_EXTENDED_API */
 
     public:
+        SPI_USCI() {
+            isr_usci_spi_instance[usci_spi_instance] = this;
+            _job_head = 0;
+            _job_tail = 0;
+            _job_pos = 0;
+            _job_in_callback = false;
+        };
+
         NEVER_INLINE
         void begin(void) {
+            usci_isr_installer();
+
             ucxctl1 |= UCSWRST;
-            ucxctl0 = _derive_ctl0_bits(_settings);
-            configClock(_settings._clock);
+            _load_image(_image_of(_settings));
 
             set_pxsel(sclk_pxsel, sclk_pxsel2, sclk_pxsel_specification, sclk_pxbits);
             set_pxsel(mosi_pxsel, mosi_pxsel2, mosi_pxsel_specification, mosi_pxbits);
@@ -110,11 +211,18 @@ class SPI_USCI : public SPIClass {
 
             ucxctl1 = UCSSEL_2;
             _transaction_semaphore = false;
-            _mask_irq = 0;
+            _transaction_released = false;
+            _mask_pins = 0;
+            _mask_max = 0;
+            _deferred_count = 0;
+            _deferred_running = false;
         };
 
         NEVER_INLINE
         void end(void) {
+            ucxie &= ~ucxrxie;  // Abandon any queued asynchronous transfers and streams
+            _job_tail = _job_head;
+            _stream.stop();
             ucxctl1 |= UCSWRST;
             ucxctl0 &= ~UCSYNC;
             set_pxsel(sclk_pxsel, sclk_pxsel2, PORT_SELECTION_NONE, sclk_pxbits);
@@ -131,14 +239,216 @@ class SPI_USCI : public SPIClass {
             return ucxrxbuf;
         };
 
+        /* Buffer transfers keep UCxTXBUF one byte ahead of the shift register, polling TXIFG/RXIFG instead of
+         * UCBUSY, so SCLK runs back to back.  Each RX byte has to be collected within one byte time of the next
+         * one starting - an interrupt longer than that during a transfer overruns it (UCOE), so at high SCLK
+         * rates keep heavy ISRs out with beginTransaction()/usingInterrupt().
+         * All of these return with the USCI idle and RXIFG clear, as transfer(uint8_t) does.
+         */
+        NEVER_INLINE
+        void transfer(const void *tx, void *rx, size_t n) {
+            const uint8_t *t = (const uint8_t *)tx;
+            uint8_t *r = (uint8_t *)rx;
+            unsigned int step = 1;
+
+            if (!n)
+                return;
+            if (r == NULL) {
+                write(tx, n);
+                return;
+            }
+            if (t == NULL) {
+                t = &_usci_spi_fill;
+                step = 0;
+            }
+
+            while (ucxstat & UCBUSY)
+                ;
+            ucxtxbuf = *t;  // Moves straight into the shift register, leaving TXBUF free for the next byte
+            while (--n) {
+                t += step;
+                while (!(ucxifg & ucxtxifg))
+                    ;
+                ucxtxbuf = *t;
+                while (!(ucxifg & ucxrxifg))
+                    ;
+                *r++ = ucxrxbuf;
+            }
+            while (!(ucxifg & ucxrxifg))
+                ;
+            *r = ucxrxbuf;
+        };
+
+        void transfer(void *buf, size_t n) { transfer(buf, buf, n); };
+
+        NEVER_INLINE
+        void write(const void *buf, size_t n) {
+            const uint8_t *t = (const uint8_t *)buf;
+            unsigned int step = 1;
+
+            if (t == NULL) {
+                t = &_usci_spi_fill;
+                step = 0;
+            }
+            while (n--) {
+                while (!(ucxifg & ucxtxifg))
+                    ;
+                ucxtxbuf = *t;
+                t += step;
+            }
+            while (ucxstat & UCBUSY)
+                ;
+            uint8_t discard = ucxrxbuf;  // Clears RXIFG and UCOE left over from the unread replies
+            (void)discard;
+        };
+
+        /* Asynchronous transfers run one byte per RX interrupt: each RXIFG stores the reply and loads the next
+         * byte, so there's never a second byte in flight to overrun however late the ISR is.  Slower on the
+         * wire than the polled loop, but the CPU is free (or in LPM0, see wait()) in between.
+         */
+        NEVER_INLINE
+        boolean transferAsync(const void *tx, void *rx, size_t n, SPI_ASYNC_CALLBACK callback = NULL, void *arg = NULL) {
+            if (!n)
+                return false;
+
+            uint8_t rxie_save = ucxie & ucxrxie;
+            ucxie &= ~ucxrxie;  // Keep the ISR off the queue; also makes this safe to call from a callback
+            unsigned int head = _job_head;
+            if (head - _job_tail == SPI_USCI_ASYNC_QUEUE_LEN) {
+                ucxie |= rxie_save;
+                return false;
+            }
+
+            struct spi_usci_async_job *j = &_jobs[head & (SPI_USCI_ASYNC_QUEUE_LEN - 1)];
+            j->tx = (const uint8_t *)tx;
+            j->rx = (uint8_t *)rx;
+            j->n = n;
+            j->callback = callback;
+            j->arg = arg;
+            __asm__ __volatile__ ("" ::: "memory");  // Job contents before the index that publishes it
+            _job_head = head + 1;
+
+            if (head == _job_tail && !_job_in_callback) {
+                // Engine was idle; clock out the first byte
+                _job_pos = 0;
+                while (ucxstat & UCBUSY)
+                    ;
+                ucxtxbuf = _job_byte(j, 0);
+            }
+            ucxie |= ucxrxie;
+            return true;
+        };
+
+        boolean isBusy(void) { return _job_head != _job_tail; };
+
+        NEVER_INLINE
+        void wait(void) {
+            if ( !(__get_SR_register() & GIE) ) {
+                // The ISR can't run, so drive the engine from here
+                while (_job_head != _job_tail) {
+                    if (ucxifg & ucxrxifg)
+                        isr_handle_rx();
+                }
+                return;
+            }
+            while (1) {
+                __bic_SR_register(GIE);
+                if (_job_head == _job_tail)
+                    break;
+                __bis_SR_register(LPM0_bits | GIE);  // Atomically sleeps; the RX ISR wakes us once the queue drains
+            }
+            __bis_SR_register(GIE);
+        };
+
+        /* Streams run on the same one-byte-per-RX-interrupt engine as asynchronous transfers, so there's no
+         * second byte in flight to overrun.  A paced stream's bytes within a frame follow each other after the
+         * ISR latency, but each frame starts exactly at its streamTick().
+         */
+        NEVER_INLINE
+        boolean beginStream(const void *tx, void *rx, size_t half_size, SPI_STREAM_CALLBACK callback, void *arg = NULL, size_t frame_size = 0) {
+            if (!half_size || (frame_size && half_size % frame_size) || _stream.active())
+                return false;
+            wait();  // Let queued asynchronous transfers finish first
+
+            _stream.start(tx, rx, half_size, callback, arg, frame_size);
+            while (ucxstat & UCBUSY)
+                ;
+            uint8_t discard = ucxrxbuf;  // Stale RXIFG would count as the first byte
+            (void)discard;
+            if (!_stream.paced())
+                ucxtxbuf = _stream.nextTx();
+            ucxie |= ucxrxie;
+            return true;
+        };
+
+        // Paced streams - call at the frame rate, e.g. from a timer ISR
+        void streamTick(void) {
+            if (_stream.tick())
+                ucxtxbuf = _stream.nextTx();
+        };
+
+        void streamRelease(uint8_t half) { _stream.release(half); };
+
+        NEVER_INLINE
+        void endStream(void) {
+            ucxie &= ~ucxrxie;
+            _stream.stop();
+            while (ucxstat & UCBUSY)
+                ;
+            uint8_t discard = ucxrxbuf;
+            (void)discard;
+        };
+
+        unsigned long streamUnderruns(boolean reset = false) { return _stream.underruns(reset); };
+        unsigned long streamOverruns(boolean reset = false) { return _stream.overruns(reset); };
+
+        // ISR handler - deliberately inlinable so USCI_SPI_ISR_BIND() (usci_isr.h) can inline it into the USCI vectors
+        boolean isr_handle_rx(void) {
+            if (_stream.active()) {
+                boolean half_done;
+                if (_stream.received(ucxrxbuf, half_done))
+                    ucxtxbuf = _stream.nextTx();
+                return half_done;  // Wakes a mainline sleeping until the next half is ready
+            }
+
+            struct spi_usci_async_job *j = &_jobs[_job_tail & (SPI_USCI_ASYNC_QUEUE_LEN - 1)];
+            uint8_t c = ucxrxbuf;
+
+            if (j->rx)
+                j->rx[_job_pos] = c;
+            if (++_job_pos < j->n) {
+                ucxtxbuf = _job_byte(j, _job_pos);
+                return false;
+            }
+
+            // Job complete - retire it before the callback so the callback may queue another
+            SPI_ASYNC_CALLBACK callback = j->callback;
+            void *arg = j->arg;
+            _job_tail = _job_tail + 1;
+            _job_pos = 0;
+            if (callback != NULL) {
+                _job_in_callback = true;
+                callback(arg);
+                _job_in_callback = false;
+            }
+
+            if (_job_head != _job_tail) {
+                ucxtxbuf = _job_byte(&_jobs[_job_tail & (SPI_USCI_ASYNC_QUEUE_LEN - 1)], 0);
+                return false;
+            }
+            ucxie &= ~ucxrxie;
+            return true;
+        };
+
         NEVER_INLINE
         void setBitOrder(unsigned int msblsb) {
             _settings._bitorder = msblsb;
+            _settings._image = SPI_SETTINGS_NO_IMAGE;
 
             uint8_t was_ucrst = ucxctl1 & UCSWRST;
             ucxctl1 |= UCSWRST;
 
-            ucxctl0 = _derive_ctl0_bits(_settings);
+            _load_image(_image_of(_settings));
 
             ucxctl1 = (ucxctl1 & ~UCSWRST) | was_ucrst;
         };
@@ -146,11 +456,12 @@ class SPI_USCI : public SPIClass {
         NEVER_INLINE
         void setDataMode(unsigned int mode) {
             _settings._datamode = mode;
+            _settings._image = SPI_SETTINGS_NO_IMAGE;
 
             uint8_t was_ucrst = ucxctl1 & UCSWRST;
             ucxctl1 |= UCSWRST;
 
-            ucxctl0 = _derive_ctl0_bits(_settings);
+            _load_image(_image_of(_settings));
 
             ucxctl1 = (ucxctl1 & ~UCSWRST) | was_ucrst;
         };
@@ -163,17 +474,9 @@ class SPI_USCI : public SPIClass {
 
         NEVER_INLINE
         void configClock(unsigned long bitrate) {
-            uint32_t smclk = F_CPU;
-            uint16_t clkdiv = smclk / bitrate;
-
-            if (smclk % bitrate != 0) {
-                /* Partial division will leave us with a divider that produces too fast a clock
-                 *
-                 * Also this condition will always match if smclk < spi_master_clk,
-                 * ensuring clockdiv of /1 will always end up the case there.
-                 */
-                clkdiv++;
-            }
+            uint16_t clkdiv = usci_spi_clkdiv(F_CPU, bitrate);
+
+            _settings._image = SPI_SETTINGS_NO_IMAGE;  // Hardware no longer matches the cached image
 
             uint8_t was_ucrst = ucxctl1 & UCSWRST;
             ucxctl1 |= UCSWRST;
@@ -186,61 +489,157 @@ class SPI_USCI : public SPIClass {
             ucxctl1 = (ucxctl1 & ~UCSWRST) | was_ucrst;
         };
 
-        NEVER_INLINE
-        boolean beginTransaction(SPISettings settings) {
-            // For atomicity in semaphore check
+        /* Transaction arbitration.  GIE is only ever cleared for a test-and-set of the semaphore or a queue
+         * update of at most SPI_USCI_DEFERRED_QUEUE_LEN entries, never across a transaction, and SR is restored
+         * rather than GIE set, so all of this is callable from ISRs.  A transaction masks just the
+         * usingInterrupt() pins (one bic.b per port), timed with micros() for maskedMicros().
+         */
+        boolean _acquire(void) {
+            unsigned int sr = __get_SR_register();
+
             __bic_SR_register(GIE);
-            if (_transaction_semaphore) {
-                __bis_SR_register(GIE);
-                return false;
-            }
+            boolean free = !_transaction_semaphore;
             _transaction_semaphore = true;
-            if (_mask_irq && _mask_irq != 255)
-                maskInterrupt(_mask_irq);
-            // Re-enable GIE but only if _mask_irq != 255
-            if (_mask_irq != 255)
-                __bis_SR_register(GIE);
+            __bis_SR_register(sr & GIE);
+            return free;
+        };
 
-            _settings_old.copy(_settings);
+        // Holding the semaphore: mask, wait out asynchronous transfers queued beforehand and load the settings
+        void _enter(const SPISettings & settings) {
+            if (_mask_pins) {
+                maskInterrupts(_mask_pins);
+                _mask_start = micros();
+            }
+            wait();
+            uint32_t image = _image_of(settings);  // Division only happens the first time these settings are used
+            uint32_t loaded = _settings._image;
+            if (!_transaction_released)
+                _settings_old.copy(_settings);  // Otherwise _settings_old still holds the settings to restore
+            _transaction_released = false;
             _settings.copy(settings);
 
-            ucxctl1 |= UCSWRST;
-            ucxctl0 = _derive_ctl0_bits(_settings);
-            configClock(_settings._clock);
-            ucxctl1 &= ~UCSWRST;
+            if (image != loaded) {
+                ucxctl1 |= UCSWRST;
+                _load_image(image);
+                ucxctl1 &= ~UCSWRST;
+            }
+        };
+
+        void _leave(void) {
+            if (_mask_pins) {
+                unsigned long masked = micros() - _mask_start;
+                unmaskInterrupts(_mask_pins);
+                if (masked > _mask_max)
+                    _mask_max = masked;
+            }
+            _transaction_semaphore = false;
+            _run_deferred();
+        };
+
+        // Takes the bus along with the first queued request, if both are there
+        boolean _pop_deferred(struct spi_usci_deferred_transaction & d) {
+            unsigned int sr = __get_SR_register();
+            boolean popped = false;
+
+            __bic_SR_register(GIE);
+            if (_deferred_count && !_transaction_semaphore) {
+                d = _deferred[0];
+                _deferred_count--;
+                for (uint8_t i = 0; i < _deferred_count; i++)
+                    _deferred[i] = _deferred[i + 1];
+                _transaction_semaphore = true;
+                popped = true;
+            }
+            __bis_SR_register(sr & GIE);
+            return popped;
+        };
+
+        // Requests queued meanwhile are picked up by the outermost loop rather than by recursion
+        void _run_deferred(void) {
+            struct spi_usci_deferred_transaction d;
 
+            if (_deferred_running)
+                return;
+            _deferred_running = true;
+            while (_pop_deferred(d)) {
+                _enter(d.settings);
+                d.callback(d.arg);
+                endTransaction();
+            }
+            _deferred_running = false;
+        };
+
+        NEVER_INLINE
+        boolean beginTransaction(const SPISettings & settings) {
+            if (!_acquire())
+                return false;
+            _enter(settings);
             return true;
         };
 
         NEVER_INLINE
         void endTransaction(void) {
-            __bic_SR_register(GIE);
-            _transaction_semaphore = false;
-            if (_mask_irq && _mask_irq != 255)
-                unmaskInterrupt(_mask_irq);
-
-            // Restore SPI settings under GIE=0 protection in case an IRQ fires which uses SPI and expects
-            // the default SPISettings parameters to be active.
+            wait();
+            // Restored before the bus is released, so nobody sees the old transaction's settings
+            uint32_t image = _image_of(_settings_old);
+            if (image != _settings._image) {
+                ucxctl1 |= UCSWRST;
+                _load_image(image);
+                ucxctl1 &= ~UCSWRST;
+            }
             _settings.copy(_settings_old);
-            ucxctl1 |= UCSWRST;
-            ucxctl0 = _derive_ctl0_bits(_settings);
-            configClock(_settings._clock);
-            ucxctl1 &= ~UCSWRST;
+            _leave();
+        };
 
-            __bis_SR_register(GIE);
+        NEVER_INLINE
+        void releaseTransaction(void) {
+            wait();
+            _transaction_released = true;
+            _leave();
         };
 
         NEVER_INLINE
-        void usingInterrupt(int pin) {
-            if (pin == 255) {
-                _mask_irq = 255;
-                return;
+        boolean requestTransaction(const SPISettings & settings, SPI_TRANSACTION_CALLBACK callback, void *arg = NULL, uint8_t priority = 0) {
+            unsigned int sr = __get_SR_register();
+            uint8_t i;
+
+            __bic_SR_register(GIE);
+            if (!_transaction_semaphore) {
+                _transaction_semaphore = true;
+                __bis_SR_register(sr & GIE);
+                _enter(settings);
+                callback(arg);
+                endTransaction();
+                return true;
             }
-            if (pin < 1 || pin > 16)
-                return;
-            _mask_irq = pin;
+            if (_deferred_count == SPI_USCI_DEFERRED_QUEUE_LEN) {
+                __bis_SR_register(sr & GIE);
+                return false;
+            }
+            for (i = _deferred_count; i && _deferred[i - 1].priority < priority; i--)
+                _deferred[i] = _deferred[i - 1];
+            _deferred[i].settings.copy(settings);
+            _deferred[i].callback = callback;
+            _deferred[i].arg = arg;
+            _deferred[i].priority = priority;
+            _deferred_count++;
+            __bis_SR_register(sr & GIE);
+            return true;
         };
 
+        // Pins 1-16 are masked during transactions; 255 (mask everything, i.e. GIE) is not supported
+        void usingInterrupt(int pin) {
+            if (pin >= 1 && pin <= 16)
+                _mask_pins |= 1U << (pin - 1);
+        };
+
+        void notUsingInterrupt(int pin) {
+            if (pin >= 1 && pin <= 16)
+                _mask_pins &= ~(1U << (pin - 1));
+        };
+
+        unsigned long maskedMicros(boolean reset = false) { unsigned long n = _mask_max; if (reset) _mask_max = 0; return n; };
+
 #ifdef SPI_ENABLE_EXTENDED_API
         boolean hasExtendedAPI(void) { return true; };
 
@@ -305,6 +704,28 @@ class SPI_USCI : public SPIClass {
             }
             return retw;
         };
+
+        /* Packs each run of 8 words into 9 bytes for the pipelined 8-bit write() path, so only the last n % 8
+         * words go through _manual_9th_bit().  Write-only - whatever comes back is discarded.
+         */
+        NEVER_INLINE
+        void transfer9(const uint16_t *words, size_t n) {
+            uint8_t packed[4 * 9];
+            boolean msbfirst = (_settings._bitorder == MSBFIRST);
+
+            while (n >= 8) {
+                size_t len = 0;
+                while (n >= 8 && len < sizeof(packed)) {
+                    usci_spi_pack9(words, packed + len, msbfirst);
+                    words += 8;
+                    n -= 8;
+                    len += 9;
+                }
+                write(packed, len);
+            }
+            while (n--)
+                transfer9(*words++);
+        };
 #endif /* SPI_ENABLE_EXTENDED_API */
 };
 
@@ -0,0 +1,34 @@
+/* SPI_USCI intermediate class defining the ISR handlers - so that the ISRs can reference a non-templated class name */
+
+#ifndef SPI_USCI_EXTISR_H
+#define SPI_USCI_EXTISR_H
+
+
+#include <SPI.h>
+#include <Stream.h>
+
+// USCI modules that can run SPI; indexes isr_usci_spi_instance[]
+enum USCI_SPI_Instance {
+    USCI_SPI_A0 = 0,
+    USCI_SPI_B0 = 1
+};
+
+class SPI_USCI_EXTISR : public SPIClass {
+    public:
+        virtual boolean isr_handle_rx(void) = 0;    // Utility function used by ISR handler
+        // isr_handle_rx returns boolean indicating:
+        // true = Wake CPU from LPM (the asynchronous transfer queue drained)
+        // false = Don't wake CPU
+};
+
+// Chip select callback for SPI_USCI_Slave; runs in interrupt context
+typedef void(*SPI_SLAVE_CS_CALLBACK)(boolean selected);
+
+class SPI_USCI_Slave_EXTISR : public Stream {
+    public:
+        virtual boolean isr_handle_rx(void) = 0;    // One byte clocked by the master; same return convention as above
+        virtual void isr_cs_edge(void) = 0;         // Chip select pin changed
+};
+
+
+#endif /* SPI_USCI_EXTISR_H */
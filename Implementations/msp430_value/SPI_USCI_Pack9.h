@@ -0,0 +1,43 @@
+/* SPI_USCI_Pack9 - 9-bit word packing for SPI_USCI::transfer9(const uint16_t *, size_t)
+ *
+ * The USCI only shifts 8-bit characters, so streams of 9-bit words (3-wire LCDs and the like) are packed
+ * 8 words to 9 bytes and sent through the pipelined 8-bit write() path.  No hardware access here, so the
+ * packing can be checked on the host against a model of the shifter (test/pack9_host.cpp).
+ */
+
+#ifndef SPI_USCI_PACK9_H
+#define SPI_USCI_PACK9_H
+
+#include <AbstractWiring.h>
+
+/* Packs 8 nine-bit words into the 9 bytes that, shifted out by the USCI in the given bit order, put the same
+ * 72 bits on the wire as 8 transfer9() calls: bit 8 first then bits 7-0 (MSB first), or bits 0-8 (LSB first).
+ */
+inline void usci_spi_pack9(const uint16_t *words, uint8_t *out, boolean msbfirst)
+{
+    uint16_t acc = 0;  // nbits (< 8) bits not yet output, plus the 9 just added - at most 16
+    unsigned int nbits = 0;
+
+    for (unsigned int i = 0; i < 8; i++) {
+        uint16_t w = words[i] & 0x1FF;
+        if (msbfirst) {
+            acc = (uint16_t)(acc << 9) | w;
+            nbits += 9;
+            while (nbits >= 8) {
+                nbits -= 8;
+                *out++ = (uint8_t)(acc >> nbits);
+            }
+            acc &= (1U << nbits) - 1;
+        } else {
+            acc |= w << nbits;
+            nbits += 9;
+            while (nbits >= 8) {
+                *out++ = (uint8_t)acc;
+                acc >>= 8;
+                nbits -= 8;
+            }
+        }
+    }
+}
+
+#endif /* SPI_USCI_PACK9_H */
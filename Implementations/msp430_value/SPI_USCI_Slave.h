@@ -0,0 +1,264 @@
+/* MSP430 SPI Slave implementation - interrupt-driven, for USCI_A or USCI_B in synchronous mode */
+
+#ifndef SPI_USCI_SLAVE_H
+#define SPI_USCI_SLAVE_H
+
+#include <AbstractWiring.h>
+#include <RingBuffer.h>
+#include <SPI_USCI.h>
+#include <SPI_USCI_EXTISR.h>
+#include <usci_isr.h>
+
+/* The master clocks one byte in and one byte out at a time; the RX vector handles both, so there is exactly
+ * one interrupt per byte.  TXBUF is double buffered: begin() (and each deselect) preloads the shift register
+ * and TXBUF, and every RXIFG refills TXBUF with the byte after next, so the ISR has a whole byte time to run
+ * before the USCI would underrun.  That is what bounds the usable SCLK: at most 8 * MCLK / (RX vector cycles),
+ * less whatever other interrupts take.  test/spislavebench.cpp measures the vector and prints that limit -
+ * bind the ISR statically with USCI_SPI_SLAVE_ISR_BIND() and USCI_ISR_BIND_VECTORS() to keep it short.
+ *
+ * Bytes sent to the master come from, in order: the response buffer set with setResponse() (rewound at every
+ * deselect, so a fixed header/status block goes out at the start of each transaction), the TX ring filled by
+ * write()/print(), then the fill byte (counted as an underrun).  Received bytes go to the RX ring for read().
+ *
+ * With an STE pin (any pxsel specification other than PORT_SELECTION_NONE) the USCI runs in 4-pin mode, STE
+ * active low, and only drives MISO while selected.  Passing that same pin's number to begin() also hooks its
+ * edges: on deselect the half-shifted byte is discarded, the response rewinds and TX is preloaded again, and
+ * the onSelect() callback (if any) is called on both edges from the port ISR - on deselect before the
+ * preload, so it can update the response for the next transaction.  TX ring bytes are only read
+ * ahead into the USCI (up to two at a time) and popped once their RXIFG shows they were clocked out, so
+ * ones a deselect discards - the partial byte and TXBUF - go out again in the next transaction.
+ */
+template <
+    enum USCI_SPI_Instance usci_spi_instance,
+    u8_SFR ucxctl0,
+    u8_SFR ucxctl1,
+    u8_SFR ucxstat,
+    u8_SFR ucxtxbuf,
+    u8_CSFR ucxrxbuf,
+    u8_SFR ucxifg,
+    uint8_t ucxtxifg,
+    uint8_t ucxrxifg,
+    u8_SFR ucxie,
+    uint8_t ucxrxie,
+    size_t tx_buffer_size,
+    size_t rx_buffer_size,
+    u8_SFR sclk_pxsel,
+    u8_SFR sclk_pxsel2,
+    const uint8_t sclk_pxbits,
+    enum PortselMode sclk_pxsel_specification,
+    u8_SFR mosi_pxsel,
+    u8_SFR mosi_pxsel2,
+    const uint8_t mosi_pxbits,
+    enum PortselMode mosi_pxsel_specification,
+    u8_SFR miso_pxsel,
+    u8_SFR miso_pxsel2,
+    const uint8_t miso_pxbits,
+    enum PortselMode miso_pxsel_specification,
+    u8_SFR ste_pxsel,
+    u8_SFR ste_pxsel2,
+    const uint8_t ste_pxbits,
+    enum PortselMode ste_pxsel_specification >
+
+class SPI_USCI_Slave : public SPI_USCI_Slave_EXTISR {
+    private:
+        RingBuffer<uint8_t, tx_buffer_size> txbuffer;
+        RingBuffer<uint8_t, rx_buffer_size> rxbuffer;
+        const uint8_t *_resp_start, *_resp_end;
+        const uint8_t *_resp;  // Next response byte; only the ISR side moves it
+        uint8_t _fill;
+        int _cs_pin;
+        volatile SPI_SLAVE_CS_CALLBACK _cs_callback;
+        unsigned long _rx_dropped, _overruns, _tx_underruns;
+
+        // Where the bytes loaded into the USCI came from - bit 0 the shift register, bit 1 TXBUF
+        uint8_t _ring_slots, _fill_slots;
+
+        // Byte for the given slot; TX ring bytes are peeked here and only popped by _sent()
+        uint8_t _next_tx(uint8_t slot) {
+            unsigned int queued = (_ring_slots & 1) + (_ring_slots >> 1);
+
+            if (_resp != _resp_end)
+                return *_resp++;
+            if (txbuffer.available() > queued) {
+                _ring_slots |= slot;
+                return txbuffer.peek(queued);
+            }
+            _fill_slots |= slot;
+            return _fill;
+        };
+
+        // The shift register's byte has been clocked out (RXIFG) and TXBUF's has moved into it
+        void _sent(void) {
+            if (_ring_slots & 1)
+                txbuffer.pop();
+            if (_fill_slots & 1)
+                _tx_underruns++;
+            _ring_slots >>= 1;
+            _fill_slots >>= 1;
+        };
+
+        void _receive(void) {
+            if (ucxstat & UCOE)
+                _overruns++;  // Cleared by the RXBUF read below
+            if (!rxbuffer.push(ucxrxbuf))
+                _rx_dropped++;
+        };
+
+        // Release UCSWRST and preload the shift register and TXBUF
+        void _start(void) {
+            _ring_slots = 0;
+            _fill_slots = 0;
+            ucxctl1 &= ~UCSWRST;
+            ucxtxbuf = _next_tx(1);
+            if (ucxifg & ucxtxifg)
+                ucxtxbuf = _next_tx(2);
+            ucxie |= ucxrxie;  // UCSWRST cleared this
+        };
+
+        static void _cs_isr(void) { isr_usci_spi_slave_instance[usci_spi_instance]->isr_cs_edge(); };
+
+    public:
+        SPI_USCI_Slave() {
+            isr_usci_spi_slave_instance[usci_spi_instance] = this;
+            _resp_start = NULL;
+            _resp_end = NULL;
+            _resp = NULL;
+            _fill = 0xFF;
+            _cs_pin = 0;
+            _cs_callback = NULL;
+            _rx_dropped = 0;
+            _overruns = 0;
+            _tx_underruns = 0;
+            _ring_slots = 0;
+            _fill_slots = 0;
+        };
+
+        // cs_pin = the STE pin's number, to hook its edges (4-pin mode only), or 0
+        NEVER_INLINE
+        void begin(uint8_t bitorder = MSBFIRST, uint8_t datamode = SPI_MODE0, int cs_pin = 0) {
+            usci_isr_installer();
+
+            ucxctl1 = UCSWRST;
+            ucxctl0 = UCSYNC | (bitorder == MSBFIRST ? UCMSB : 0) | usci_spi_mode_bits(datamode)
+                    | (ste_pxsel_specification != PORT_SELECTION_NONE ? UCMODE_2 : UCMODE_0);
+            set_pxsel(sclk_pxsel, sclk_pxsel2, sclk_pxsel_specification, sclk_pxbits);
+            set_pxsel(mosi_pxsel, mosi_pxsel2, mosi_pxsel_specification, mosi_pxbits);
+            set_pxsel(miso_pxsel, miso_pxsel2, miso_pxsel_specification, miso_pxbits);
+            set_pxsel(ste_pxsel, ste_pxsel2, ste_pxsel_specification, ste_pxbits);
+
+            txbuffer.clear();
+            rxbuffer.clear();
+            _resp = _resp_start;
+            _start();
+
+            _cs_pin = cs_pin;
+            if (_cs_pin > 0)
+                attachInterrupt(_cs_pin, _cs_isr, CHANGE);
+        };
+
+        NEVER_INLINE
+        void end(void) {
+            if (_cs_pin > 0)
+                detachInterrupt(_cs_pin);
+            ucxctl1 |= UCSWRST;
+            ucxctl0 &= ~UCSYNC;
+            set_pxsel(sclk_pxsel, sclk_pxsel2, PORT_SELECTION_NONE, sclk_pxbits);
+            set_pxsel(mosi_pxsel, mosi_pxsel2, PORT_SELECTION_NONE, mosi_pxbits);
+            set_pxsel(miso_pxsel, miso_pxsel2, PORT_SELECTION_NONE, miso_pxbits);
+            set_pxsel(ste_pxsel, ste_pxsel2, PORT_SELECTION_NONE, ste_pxbits);
+        };
+
+        /* buf is clocked out at the start of every transaction until replaced (or NULL); it must stay valid.
+         * Starts at once if the previous response has been sent in full; otherwise that one is cut short and
+         * this one starts at the next deselect.
+         */
+        NEVER_INLINE
+        void setResponse(const void *buf, size_t len) {
+            unsigned int sr = __get_SR_register();
+
+            __bic_SR_register(GIE);  // Both the RX and the chip select ISR use the response pointers
+            boolean sent = (_resp == _resp_end);
+            _resp_start = (const uint8_t *)buf;
+            _resp_end = _resp_start + (buf != NULL ? len : 0);
+            _resp = sent ? _resp_start : _resp_end;
+            __bis_SR_register(sr & GIE);
+        };
+
+        void setFill(uint8_t c) { _fill = c; };
+        void onSelect(SPI_SLAVE_CS_CALLBACK callback) { _cs_callback = callback; };
+
+        // Stream API
+        int available(void) { return rxbuffer.available(); };
+
+        int read(void) {
+            if (rxbuffer.isEmpty())
+                return -1;
+            return rxbuffer.pop();
+        };
+
+        int peek(void) {
+            if (rxbuffer.isEmpty())
+                return -1;
+            return rxbuffer.peek();
+        };
+
+        // Returns once the master has clocked out everything queued by write()
+        void flush(void) { while (!txbuffer.isEmpty()) ; };
+
+        using Print::write;
+
+        // Never blocks, as it's up to the master when the bytes leave; returns how many were queued
+        size_t write(uint8_t c) { return txbuffer.push(c) ? 1 : 0; };
+
+        size_t write(const uint8_t *buf, size_t len) {
+            size_t done = 0;
+            uint8_t *p;
+            unsigned int n;
+
+            while (done < len && (n = txbuffer.writeSpan(p)) != 0) {
+                if (n > len - done)
+                    n = len - done;
+                memcpy(p, buf + done, n);
+                txbuffer.commit(n);
+                done += n;
+            }
+            return done;
+        };
+
+        int availableForWrite(void) { return txbuffer.availableForWrite(); };
+
+        // Bytes lost to a full RX ring, UCOE overruns and fill bytes sent for lack of data
+        unsigned long rxDropped(boolean reset = false) { unsigned long n = _rx_dropped; if (reset) _rx_dropped = 0; return n; };
+        unsigned long overruns(boolean reset = false) { unsigned long n = _overruns; if (reset) _overruns = 0; return n; };
+        unsigned long txUnderruns(boolean reset = false) { unsigned long n = _tx_underruns; if (reset) _tx_underruns = 0; return n; };
+
+        // ISR handlers
+        boolean isr_handle_rx(void) {
+            _receive();
+            _sent();
+            if (ucxifg & ucxtxifg)
+                ucxtxbuf = _next_tx(2);
+            return false;
+        };
+
+        void isr_cs_edge(void) {
+            boolean selected = !digitalRead(_cs_pin);
+
+            if (!selected) {
+                // End of transaction - keep the last byte, drop the partial one and TXBUF (_start() reloads them)
+                if (ucxifg & ucxrxifg) {
+                    _receive();
+                    _sent();
+                }
+                ucxctl1 |= UCSWRST;
+                if (_cs_callback != NULL)
+                    _cs_callback(false);  // Before the preload, so it can refresh the response
+                _resp = _resp_start;
+                _start();
+            } else if (_cs_callback != NULL) {
+                _cs_callback(true);
+            }
+        };
+};
+
+#endif /* SPI_USCI_SLAVE_H */
@@ -4,7 +4,9 @@
 #define UART_USCI_H
 
 #include <AbstractWiring.h>
+#include <RingBuffer.h>
 #include <UART_USCI_EXTISR.h>
+#include <UART_USCI_Divisor.h>
 #include <usci_isr.h>
 
 
@@ -31,115 +33,383 @@ template <
 
 class UART_USCI : public UART_USCI_EXTISR {
     private:
-	volatile char txbuffer[tx_buffer_size], rxbuffer[rx_buffer_size];
-        volatile unsigned int tx_head, tx_tail;
-        volatile unsigned int rx_head, rx_tail;
+        RingBuffer<uint8_t, tx_buffer_size> txbuffer;
+        RingBuffer<uint8_t, rx_buffer_size> rxbuffer;
         unsigned long _baud;
         volatile SERIAL_BREAK_CALLBACK breakcb;
-
-    public:
-        UART_USCI() {
-            isr_usci_uart_instance[usci_a_instance] = this;
-	};
+        int _frame_delim;
+        volatile unsigned int _frames_in, _frames_out;  // Completed frames, counted by the RX ISR and readFrame()
+        volatile boolean _rx_truncated;  // The RX ISR cut a frame short on a full ring; cleared once readFrame() drained it
+        boolean _rx_skipping;  // RX ISR is dropping the rest of a frame, up to and including its delimiter
+        enum SerialTxPolicy _tx_policy;
+        unsigned long _tx_timeout;
+        unsigned long _tx_dropped;
+#ifdef SERIAL_ENABLE_STATS
+        struct SerialStats _stats;
+#endif
 
 	NEVER_INLINE
-        void begin(unsigned long bitrate) {
+        void _reset(unsigned long bitrate) {
             usci_isr_installer();
 
             _baud = bitrate;
             ucactl1 = UCSWRST;
             ucactl1 |= UCSSEL_2;
+#ifdef SERIAL_ENABLE_STATS
+            ucactl1 |= UCRXEIE;  // Let framing/parity errors reach the RX ISR so they get counted
+#endif
             ucactl0 = 0x00;  // Parity = none, 8 bits, 1 stop bit, LSB first.
             ucaabctl = 0x00;
+        };
 
-            configClock(bitrate);
-
+	NEVER_INLINE
+        void _start(void) {
             ucactl1 &= ~(UCSWRST);
             set_pxsel(pxsel, pxsel2, pxsel_specification, pxbits);
+            txbuffer.clear();
+            rxbuffer.clear();
+            _frames_out = _frames_in;
+            _rx_truncated = false;
+            _rx_skipping = false;
             ucaie |= ucarxie;
+        };
+
+        /* TX ring is full; apply the overflow policy.  Returns false if the bytes should be dropped instead,
+         * true once there's room - for SERIAL_TX_DROP_OLDEST, room for up to `need' bytes.  `since' is when
+         * this write() first found the ring full, so the timeout covers the whole call.
+         */
+	NEVER_INLINE
+        boolean _txMakeRoom(size_t need, unsigned long since) {
+            if (_tx_policy == SERIAL_TX_DROP_NEWEST)
+                return false;
+            if (_tx_policy == SERIAL_TX_DROP_OLDEST) {
+                ucaie &= ~ucatxie;  // The tail belongs to the TX ISR; keep it out while we move it
+                size_t used = txbuffer.available();
+                if (need > used)
+                    need = used;
+                txbuffer.consume(need);
+                _tx_dropped += need;
+                ucaie |= ucatxie;
+                return true;
+            }
+
+            // Blocking policies - is the peripheral suspended?
+            if (ucactl1 & UCSWRST)
+                return false;  // Not getting anywhere busy-waiting on a suspended UART!
+            // Are interrupts disabled?
+            if ( !(__get_SR_register() & GIE) )
+                return false;  // No point in waiting for TX while the USCI IRQ can't fire!
+                // ^ This should catch a common pitfall of Arduino users: Running Serial.print inside an interrupt routine.
+            while (txbuffer.isFull()) {
+                if (_tx_policy == SERIAL_TX_BLOCK_TIMEOUT && (millis() - since) >= _tx_timeout)
+                    return false;
+            }
+            return true;
+        };
+
+        // Statistics hooks - empty unless SERIAL_ENABLE_STATS is defined
+        boolean _statsRxError(void) {  // true = reject the character; must run before RXBUF is read
+#ifdef SERIAL_ENABLE_STATS
+            uint8_t stat = ucastat;
+            if (stat & UCRXERR) {
+                if (stat & UCOE)
+                    _stats.overrun++;
+                if (stat & UCFE)
+                    _stats.framing++;
+                if (stat & UCPE)
+                    _stats.parity++;
+                return (stat & (UCFE | UCPE)) != 0;
+            }
+#endif
+            return false;
+        };
+
+        void _statsRxDropped(void) {
+#ifdef SERIAL_ENABLE_STATS
+            _stats.rx_dropped++;
+#endif
+        };
+
+        void _statsRxLevel(void) {
+#ifdef SERIAL_ENABLE_STATS
+            unsigned int used = rxbuffer.available();
+            if (used > _stats.rx_high_water)
+                _stats.rx_high_water = used;
+#endif
+        };
+
+        void _statsTxLevel(void) {
+#ifdef SERIAL_ENABLE_STATS
+            unsigned int used = txbuffer.available();
+            if (used > _stats.tx_high_water)
+                _stats.tx_high_water = used;
+#endif
+        };
+
+    public:
+        UART_USCI() {
+            isr_usci_uart_instance[usci_a_instance] = this;
+            _frame_delim = -1;
+            _frames_in = 0;
+            _frames_out = 0;
+            _rx_truncated = false;
+            _rx_skipping = false;
+            _tx_policy = SERIAL_TX_BLOCK;
+            _tx_timeout = 0;
+            _tx_dropped = 0;
+#ifdef SERIAL_ENABLE_STATS
+            memset(&_stats, 0, sizeof(_stats));
+#endif
+	};
 
-            tx_head = 0;
-            tx_tail = 0;
-            rx_head = 0;
-            rx_tail = 0;
+	NEVER_INLINE
+        void begin(unsigned long bitrate) {
+            _reset(bitrate);
+            configClock(bitrate);
+            _start();
     	};
 
+        /* Constant baud rate version, e.g. Serial.begin<115200>() - the SLAU144 divisor search runs at compile
+         * time (see UART_USCI_Divisor.h) and fails the build if no setting is within max_error_ppm of a bit.
+         */
+        template <unsigned long bitrate, uint32_t max_error_ppm = USCI_UART_DEFAULT_MAX_ERROR_PPM>
+        void begin(void) {
+            typedef USCI_UART_Divisor<F_CPU, bitrate, max_error_ppm> divisor;
+
+            _reset(bitrate);
+            ucabr0 = divisor::ucabr0;
+            ucabr1 = divisor::ucabr1;
+            ucamctl = divisor::ucamctl;
+            _start();
+        };
+
 	NEVER_INLINE
         void end(void) {
             ucaie &= ~(ucatxie | ucarxie);
             set_pxsel(pxsel, pxsel2, PORT_SELECTION_NONE, pxbits);
             ucactl1 |= UCSWRST;
 
-            tx_head = 0;
-            tx_tail = 0;
-            rx_head = 0;
-            rx_tail = 0;
+            txbuffer.clear();
+            rxbuffer.clear();
         };
 
-        int available(void) { return (rx_buffer_size + rx_head - rx_tail) % rx_buffer_size; };
-        int peek(void) { if (rx_head == rx_tail) return -1; return rxbuffer[rx_tail]; };
+        int available(void) { return rxbuffer.available(); };
+        int peek(void) { if (rxbuffer.isEmpty()) return -1; return rxbuffer.peek(); };
 
 	NEVER_INLINE
         int read(void) {
-            if (rx_head == rx_tail)
+            if (rxbuffer.isEmpty())
                 return -1;
-
-            uint8_t c = rxbuffer[rx_tail];
-            rx_tail = (unsigned int)(rx_tail + 1) % rx_buffer_size;
-            return c;
+            return rxbuffer.pop();
         };
 
-        void flush(void) { while (tx_head != tx_tail) ; };
+        void flush(void) { while (!txbuffer.isEmpty()) ; };
+
+        // Bulk RX for Stream::readBytes()/readBytesUntil() - memchr/memcpy over the (at most two) ring spans
+	NEVER_INLINE
+        size_t readBuffered(uint8_t *buf, size_t len, int terminator = -1) {
+            size_t n = 0, span;
+            const uint8_t *p, *t;
+
+            while (n < len && (span = rxbuffer.readSpan(p)) != 0) {
+                boolean found = false;
+                if (span > len - n)
+                    span = len - n;
+                if (terminator >= 0 && (t = (const uint8_t *)memchr(p, terminator, span)) != NULL) {
+                    span = (t - p) + 1;
+                    found = true;
+                }
+                memcpy(buf + n, p, span);
+                rxbuffer.consume(span);
+                n += span;
+                if (found)
+                    break;
+            }
+            return n;
+        };
 
 	NEVER_INLINE
         size_t write(uint8_t c) {
-            unsigned int i = (tx_head + 1) % tx_buffer_size;
-
-            // If the output buffer is full, we must wait.
-            if (i == tx_tail) {
-                // What to do next?
-                // First: Is the peripheral suspended?
-                if (ucactl1 & UCSWRST)
-                    return 0;  // Not getting anywhere busy-waiting on a suspended UART!
-                // Second, are interrupts disabled?
-                if ( !(__get_SR_register() & GIE) )
-                    return 0;  // No point in waiting for TX while the USCI IRQ can't fire!
-                    // ^ This should catch a common pitfall of Arduino users: Running Serial.print inside an interrupt routine.
-                // Else ... just wait.
-                while (i == tx_tail)
-                    ;
+            // If the output buffer is full, the TX policy decides whether we wait or drop.
+            if (txbuffer.isFull() && !_txMakeRoom(1, millis())) {
+                _tx_dropped++;
+                return 0;
             }
 
-            txbuffer[tx_head] = c;
-            tx_head = i;
+            txbuffer.push(c);
             ucaie |= ucatxie;
+            _statsTxLevel();
             return 1;
         };
 
+        // Bulk TX - copies into the ring in at most two spans and arms TXIE once per fill, only applying
+        // the TX policy for whatever doesn't fit.
+	NEVER_INLINE
+        size_t write(const uint8_t *buf, size_t len) {
+            size_t n = 0;
+            unsigned int span;
+            uint8_t *p;
+            unsigned long since = 0;
+            boolean waited = false;
+
+            while (1) {
+                while (n < len && (span = txbuffer.writeSpan(p)) != 0) {
+                    if (span > len - n)
+                        span = len - n;
+                    memcpy(p, buf + n, span);
+                    txbuffer.commit(span);
+                    n += span;
+                }
+                if (n) {
+                    ucaie |= ucatxie;
+                    _statsTxLevel();
+                }
+                if (n == len)
+                    return n;
+
+                // Remainder doesn't fit
+                if (!waited) {
+                    since = millis();
+                    waited = true;
+                }
+                if (!_txMakeRoom(len - n, since)) {
+                    _tx_dropped += len - n;
+                    return n;
+                }
+            }
+        };
+
+        int availableForWrite(void) { return txbuffer.availableForWrite(); };
+
+	NEVER_INLINE
+        void setTxPolicy(enum SerialTxPolicy policy, unsigned long timeout_ms = 0) {
+            _tx_policy = policy;
+            _tx_timeout = timeout_ms;
+        };
+
+	NEVER_INLINE
+        unsigned long txDropped(boolean reset = false) {
+            unsigned long d = _tx_dropped;
+            if (reset)
+                _tx_dropped = 0;
+            return d;
+        };
+
+#ifdef SERIAL_ENABLE_STATS
+	NEVER_INLINE
+        boolean getStats(struct SerialStats &stats, boolean reset = false) {
+            uint8_t rxie_save = ucaie & ucarxie;
+            ucaie &= ~ucarxie;  // The RX ISR updates the counters; keep it out for a consistent snapshot
+            stats = _stats;
+            if (reset)
+                memset(&_stats, 0, sizeof(_stats));
+            ucaie |= rxie_save;
+            stats.tx_dropped = txDropped(reset);
+            return true;
+        };
+#endif
+
         operator bool() { if (ucactl1 & UCSWRST) return false; return true; };
 
+        // Zero-copy span API - direct windows into the ring buffers
+        void rxPeekSpan(const uint8_t *&p, size_t &len) { len = rxbuffer.readSpan(p); };
+
+	NEVER_INLINE
+        void rxConsume(size_t n) {
+            size_t avail = rxbuffer.available();
+            rxbuffer.consume(n < avail ? n : avail);
+        };
+
 	NEVER_INLINE
+        size_t txReserve(uint8_t *&p, size_t len) {
+            size_t span = txbuffer.writeSpan(p);
+            return (span < len ? span : len);
+        };
+
+	NEVER_INLINE
+        void txCommit(size_t n) {
+            uint8_t *p;
+            size_t span = txbuffer.writeSpan(p);  // Never publish more than txReserve() could have handed out
+            if (n > span)
+                n = span;
+            if (!n)
+                return;
+            txbuffer.commit(n);
+            ucaie |= ucatxie;
+            _statsTxLevel();
+        };
+
+        // ISR handlers - deliberately inlinable so USCI_UART_ISR_BIND() (usci_isr.h) can inline them into the USCI vectors
         void isr_send_char(void) {
-            if (tx_head == tx_tail) {
+            if (txbuffer.isEmpty()) {
                 // Buffer empty; disable interrupts
                 ucaie &= ~ucatxie;
                 return;
             }
 
-            uint8_t c = txbuffer[tx_tail];
-            tx_tail = (tx_tail + 1) % tx_buffer_size;
-            ucatxbuf = c;
+            ucatxbuf = txbuffer.pop();
         };
 
-	NEVER_INLINE
-        void isr_get_char(void) {
+        boolean isr_get_char(void) {
+            boolean bad = _statsRxError();  // Looks at UCAxSTAT, so it must come before the RXBUF read clears it
             uint8_t c = ucarxbuf;
-            unsigned int i = (rx_head + 1) % rx_buffer_size;
 
-            if (i != rx_tail) {
-                rxbuffer[rx_head] = c;
-                rx_head = i;
-            }   // else ... ignore the char (buffer full)
+            if (bad)
+                return false;  // Framing/parity error; discard it like the USCI would without UCRXEIE
+
+            if (_rx_truncated || _rx_skipping) {
+                _statsRxDropped();
+                _rx_skipping = (c != _frame_delim);
+                return false;
+            }
+            if (!rxbuffer.push(c)) {
+                _statsRxDropped();
+                if (_frame_delim < 0)
+                    return false;  // buffer full, the char is ignored
+                /* A frame which fills the ring can never see its delimiter buffered, so count it now as a truncated
+                 * frame and wake the main loop to drain it.  Until readFrame() has, everything is dropped; then
+                 * the rest of the frame in progress is skipped so the next one starts clean.
+                 */
+                _rx_truncated = true;
+                _rx_skipping = (c != _frame_delim);
+                _frames_in++;
+                return true;
+            }
+            _statsRxLevel();
+            if (c == _frame_delim) {
+                _frames_in++;
+                return true;
+            }
+            return false;
+        };
+
+        // Framed RX
+	NEVER_INLINE
+        void setFrameDelimiter(int delim) {
+            _frame_delim = delim;
+            _frames_out = _frames_in;
+            _rx_truncated = false;
+            _rx_skipping = false;
+        };
+
+        unsigned int framesAvailable(void) { return _frames_in - _frames_out; };
+
+	NEVER_INLINE
+        size_t readFrame(uint8_t *buf, size_t len) {
+            if (_frames_in == _frames_out)
+                return 0;
+            _frames_out++;
+
+            size_t n = readBuffered(buf, len, _frame_delim);
+            if (n && buf[n-1] == _frame_delim)
+                return n - 1;
+            // Frame didn't fit; drop the rest of it along with its delimiter
+            while (!rxbuffer.isEmpty())
+                if (rxbuffer.pop() == _frame_delim)
+                    return n;
+            // Drained without a delimiter - this was the frame the RX ISR cut short, so it may buffer again
+            _rx_truncated = false;
+            return n;
         };
 
 	NEVER_INLINE
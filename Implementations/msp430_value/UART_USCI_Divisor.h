@@ -0,0 +1,117 @@
+/* UART_USCI_Divisor - compile-time USCI_A baud rate divisor search (UCBRx/UCBRSx/UCBRFx/UCOS16)
+ *
+ * Models the bit timing described in TI SLAU144 (USCI_A UART "Setting a Baud Rate") and picks the register
+ * settings with the lowest worst-case bit error over a 10-bit frame (start, 8 data, stop), counting both
+ * the TX bit edges and the RX mid-bit sample points.  Everything is constexpr, so when the baud rate is a
+ * constant the search runs inside the compiler and UART_USCI::begin<baud>() reduces to constant stores.
+ */
+
+#ifndef UART_USCI_DIVISOR_H
+#define UART_USCI_DIVISOR_H
+
+#include <AbstractWiring.h>
+
+// Default static_assert threshold for USCI_UART_Divisor, in parts per million of a bit time (2%)
+#ifndef USCI_UART_DEFAULT_MAX_ERROR_PPM
+#define USCI_UART_DEFAULT_MAX_ERROR_PPM 20000UL
+#endif
+
+#define USCI_UART_FRAME_BITS 10
+
+struct usci_uart_divisor {
+    uint16_t ucbr;
+    uint8_t ucamctl;     // UCBRFx | UCBRSx | UCOS16, ready for UCAxMCTL
+    uint32_t error_ppm;  // Worst-case TX/RX bit error; 0xFFFFFFFF if no valid setting exists
+
+    constexpr usci_uart_divisor(uint16_t br, uint8_t mctl, uint32_t err) : ucbr(br), ucamctl(mctl), error_ppm(err) { };
+};
+
+// SLAU144 UCBRSx modulation pattern, bit i = modulation of frame bit (i % 8)
+constexpr uint8_t usci_uart_ucbrs_pattern(uint8_t ucbrs)
+{
+    return (ucbrs == 1) ? 0x02 :
+           (ucbrs == 2) ? 0x22 :
+           (ucbrs == 3) ? 0x2A :
+           (ucbrs == 4) ? 0xAA :
+           (ucbrs == 5) ? 0xAE :
+           (ucbrs == 6) ? 0xEE :
+           (ucbrs == 7) ? 0xFE : 0x00;
+}
+
+// Length of frame bit i in BRCLK cycles
+constexpr uint32_t usci_uart_bit_cycles(uint16_t ucbr, uint8_t ucbrs, uint8_t ucbrf, boolean os16, unsigned int i)
+{
+    return os16 ? ((16UL + ((usci_uart_ucbrs_pattern(ucbrs) >> (i & 7)) & 1)) * ucbr + ucbrf)
+                : ((uint32_t)ucbr + ((usci_uart_ucbrs_pattern(ucbrs) >> (i & 7)) & 1));
+}
+
+constexpr uint32_t usci_uart_abs_ppm(int64_t num, uint32_t den)
+{
+    return (uint32_t)(((num < 0) ? -num : num) * 1000000LL / den);
+}
+
+// Worst-case error of one setting - TX: each bit's end edge vs ideal; RX: each bit's sample point vs mid-bit
+constexpr uint32_t usci_uart_error_ppm(uint32_t brclk, uint32_t baud, uint16_t ucbr, uint8_t ucbrs, uint8_t ucbrf, boolean os16)
+{
+    uint32_t worst = 0;
+    uint32_t elapsed = 0;  // BRCLK cycles up to the start of bit i
+
+    for (unsigned int i = 0; i < USCI_UART_FRAME_BITS; i++) {
+        uint32_t bit = usci_uart_bit_cycles(ucbr, ucbrs, ucbrf, os16, i);
+        uint32_t tx = usci_uart_abs_ppm((int64_t)baud * (elapsed + bit) - (int64_t)(i + 1) * brclk, brclk);
+        uint32_t rx = usci_uart_abs_ppm((int64_t)2 * baud * (elapsed + bit / 2) - (int64_t)(2 * i + 1) * brclk, 2 * brclk);
+
+        if (tx > worst)
+            worst = tx;
+        if (rx > worst)
+            worst = rx;
+        elapsed += bit;
+    }
+    return worst;
+}
+
+/* Candidates: UCOS16=1 with UCBRx around INT(N/16) over every UCBRFx/UCBRSx (needs N >= 16), then UCOS16=0
+ * with UCBRx around INT(N) over every UCBRSx (needs N >= 3), where N = BRCLK / baud.  Ties go to the
+ * oversampling setting, which SLAU144 recommends for its majority-vote RX sampling.
+ */
+constexpr usci_uart_divisor usci_uart_best_divisor(uint32_t brclk, uint32_t baud)
+{
+    usci_uart_divisor best(0, 0, 0xFFFFFFFFUL);
+    uint32_t n = brclk / baud;
+
+    if (n >= 16) {
+        for (uint32_t br = (n / 16 > 1 ? n / 16 - 1 : 1); br <= n / 16 + 1 && br <= 0xFFFF; br++) {
+            for (uint8_t brf = 0; brf < 16; brf++) {
+                for (uint8_t brs = 0; brs < 8; brs++) {
+                    uint32_t err = usci_uart_error_ppm(brclk, baud, (uint16_t)br, brs, brf, true);
+                    if (err < best.error_ppm)
+                        best = usci_uart_divisor((uint16_t)br, (uint8_t)((brf << 4) | (brs << 1) | UCOS16), err);
+                }
+            }
+        }
+    }
+    if (n >= 3) {
+        for (uint32_t br = (n > 3 ? n - 1 : 3); br <= n + 1 && br <= 0xFFFF; br++) {
+            for (uint8_t brs = 0; brs < 8; brs++) {
+                uint32_t err = usci_uart_error_ppm(brclk, baud, (uint16_t)br, brs, 0, false);
+                if (err < best.error_ppm)
+                    best = usci_uart_divisor((uint16_t)br, (uint8_t)(brs << 1), err);
+            }
+        }
+    }
+    return best;
+}
+
+// Compile-time divisor for a constant BRCLK/baud pair; refuses to build if the best error exceeds max_error_ppm
+template <uint32_t brclk, uint32_t baud, uint32_t max_error_ppm = USCI_UART_DEFAULT_MAX_ERROR_PPM>
+struct USCI_UART_Divisor {
+    static constexpr uint32_t error_ppm = usci_uart_best_divisor(brclk, baud).error_ppm;
+    static constexpr uint16_t ucbr = usci_uart_best_divisor(brclk, baud).ucbr;
+    static constexpr uint8_t ucabr0 = (uint8_t)ucbr;
+    static constexpr uint8_t ucabr1 = (uint8_t)(ucbr >> 8);
+    static constexpr uint8_t ucamctl = usci_uart_best_divisor(brclk, baud).ucamctl;
+
+    static_assert(error_ppm <= max_error_ppm, "No USCI UART divisor setting meets the bit error limit for this clock/baud rate");
+};
+
+#endif /* UART_USCI_DIVISOR_H */
@@ -9,7 +9,10 @@
 class UART_USCI_EXTISR : public AbstractSerial {
     public:
         virtual void isr_send_char(void) = 0;       // Utility function used by ISR handler
-        virtual void isr_get_char(void) = 0;        // Utility function used by ISR handler
+        virtual boolean isr_get_char(void) = 0;     // Utility function used by ISR handler
+        // isr_get_char returns boolean indicating:
+        // true = Wake CPU from LPM (a frame delimiter arrived)
+        // false = Don't wake CPU
 };
 
 
@@ -21,9 +21,15 @@ enum USCI_TwoWire_error {
     TWI_ERROR_MTX_ADDR_NACK,
     TWI_ERROR_MRX_ADDR_NACK,
     TWI_ERROR_NACK,
-    TWI_ERROR_BUS_BUSY
+    TWI_ERROR_BUS_BUSY,
+    TWI_ERROR_TIMEOUT
 };
 
+// Default START/address phase timeout, ms
+#ifndef WIRE_USCI_ADDRESS_TIMEOUT
+#define WIRE_USCI_ADDRESS_TIMEOUT 50
+#endif
+
 
 
 template <
@@ -63,6 +69,300 @@ class Wire_USCI : public TwoWire_USCI_EXTISR {
         volatile uint16_t txhead, txtail, rxhead, rxtail;
         boolean is_slave;
 
+        // Master transfer in progress - the ISR sends _mtx, then turns around with a repeated START to fill _mrx
+        const uint8_t *_mtx;
+        uint8_t *_mrx;
+        volatile size_t _mtx_left, _mrx_left;
+        boolean _mstop;     // STOP at the end; false leaves the bus held for a repeated START
+        boolean _bus_held;  // Last master transfer ended without a STOP
+
+        /* A held write's last byte is sent with TXBUF left empty, so the USCI stalls in its ACK cycle until the
+         * next START is set.  Until that START goes out (UCTXSTT clears), a NACK is that byte's, not the
+         * address's, and the write gets the blame.
+         */
+        volatile boolean _held_ack;
+
+        /* A single-byte read's STOP has to be set while that byte comes in, i.e. once UCTXSTT clears at the
+         * end of the address.  There's no interrupt for that, so it's polled outside the ISRs (_poll_stop());
+         * if the byte arrives first the RX ISR sets the STOP late, and one extra byte is read and dropped.
+         */
+        volatile boolean _stop_pending;
+
+        /* queueTransaction() list - mainline appends with GIE off, the ISR retires the head and starts the
+         * next one.  Blocking transfers hold _blocking, so queued transactions wait for them and vice versa.
+         */
+        struct twowire_transaction * volatile _q_head;
+        struct twowire_transaction * volatile _q_tail;
+        volatile boolean _async_running;  // The master transfer in progress is _q_head
+        volatile boolean _blocking;
+
+        /* The last queued transaction's STOP is still going out.  Touching the USCI before UCTXSTP clears
+         * would cut it short, and there's no interrupt for it, so the next start (or the bus release) is left
+         * to _async_poll(), under the same deadline as an address phase.
+         */
+        volatile boolean _stop_draining;
+
+        /* START/address phase - a NACK in it is told apart from a data NACK by isr_handle_control(), and
+         * a slave or bus that never gets that far is caught by a deadline checked at each wakeup (the WDT
+         * tick wakes LPM0 every time), so nothing spins while the address goes out.
+         */
+        volatile boolean _addr_phase;
+        uint16_t _addr_start, _addr_timeout;  // In _ms16() units
+        uint16_t _default_timeout;
+
+        // Register-map slave mode, see setRegisterMap()
+        volatile uint8_t *_regs;
+        const uint8_t *_reg_writable;
+        volatile uint8_t *_reg_dirty;
+        size_t _reg_count;
+        uint16_t _reg_ptr;
+        boolean _reg_addressed;  // This write's first byte (the register pointer) is in
+
+        // Low word of the system millisecond count - one 16-bit read, so unlike millis() it can't tear
+        static uint16_t _ms16(void) { return *(const volatile uint16_t *)&_sys_millis; };
+
+        boolean _addr_expired(void) {
+            return _addr_phase && (uint16_t)(_ms16() - _addr_start) >= _addr_timeout;
+        };
+
+        void _set_slave_address(int i2caddr) {
+            i2csa = i2caddr & 0x1FF;
+            if (i2caddr & 0x180)
+                ucbctl0 |= UCSLA10;
+            else
+                ucbctl0 &= ~UCSLA10;
+        };
+
+        // Back to slave mode, or reset, after a master transfer
+        void _master_release(void) {
+            _bus_held = false;
+            if (is_slave) {
+                ucbctl1 |= UCSWRST;
+                ucbctl0 &= ~UCMST;
+                ucbctl1 &= ~UCSWRST;
+                stateie |= UCNACKIE | UCSTPIE | UCSTTIE | UCALIE;  // UCSWRST cleared these
+                txrxie |= txiebit | rxiebit;
+            } else {
+                ucbctl1 = UCSSEL_2 | UCSWRST;
+                stateie &= ~(UCSTTIE | UCSTPIE | UCALIE | UCNACKIE);
+                txrxie &= ~(txiebit | rxiebit);
+            }
+        };
+
+        // Take the USCI out of slave/idle into master mode
+        void _master_setup(void) {
+            ucbctl1 |= UCSWRST;
+            ucbctl0 |= UCMST;
+            ucbctl1 = UCSSEL_2 | UCSWRST;
+            ucbctl1 &= ~UCSWRST;
+            stateie |= UCSTTIE | UCSTPIE | UCALIE | UCNACKIE;
+            txrxie |= txiebit | rxiebit;
+        };
+
+        void _master_start(boolean transmit, uint16_t timeout) {
+            twi_state = transmit ? TWI_MTX : TWI_MRX;
+            twi_error = TWI_ERROR_NONE;
+            if (transmit)
+                ucbctl1 |= UCTR;
+            else
+                ucbctl1 &= ~UCTR;
+            _addr_phase = true;
+            _addr_start = _ms16();
+            _addr_timeout = timeout ? timeout : _default_timeout;
+            _stop_pending = !transmit && _mrx_left == 1;
+            ucbctl1 |= UCTXSTT;  // Initiate START condition
+        };
+
+        // Call with GIE off; an RXIFG already pending means the byte is in, and the RX ISR sets the STOP itself
+        void _poll_stop(void) {
+            if (_stop_pending && !(ucbctl1 & UCTXSTT) && !(txrxifg & rxifgbit)) {
+                _stop_pending = false;
+                ucbctl1 |= UCTXSTP;
+            }
+        };
+
+        // _addr_phase is cleared once the address has been ACKed, so a NACK before that is an address NACK
+        enum USCI_TwoWire_error _nack_error(void) {
+            if (!_addr_phase)
+                return TWI_ERROR_NACK;
+            return (ucbctl1 & UCTR) ? TWI_ERROR_MTX_ADDR_NACK : TWI_ERROR_MRX_ADDR_NACK;
+        };
+
+        // Starts _q_head - from the ISR right after the previous transaction, or with GIE off
+        void _async_start(void) {
+            struct twowire_transaction *t = _q_head;
+            boolean transmit = (t->txlen != 0);
+
+            _mtx = t->tx;
+            _mtx_left = t->txlen;
+            _mrx = t->rx;
+            _mrx_left = t->rxlen;
+            _mstop = true;
+            _async_running = true;
+            _set_slave_address(t->addr);
+            if (!(ucbctl0 & UCMST) || (ucbctl1 & UCSWRST))
+                _master_setup();  // First of a run, arbitration was lost or the last one timed out
+            _master_start(transmit, t->timeout_ms);  // A single-byte read's STOP is left to _poll_stop()
+        };
+
+        // ISR side - retires _q_head with the given status, then runs the next one or releases the bus
+        boolean _async_done(enum USCI_TwoWire_error status) {
+            struct twowire_transaction *t = _q_head;
+
+            _q_head = t->next;
+            if (_q_head == NULL)
+                _q_tail = NULL;
+            t->status = status;
+            if (t->callback != NULL)
+                t->callback(t);  // May queue t (or others) again
+
+            if (ucbctl1 & UCTXSTP) {  // This transaction's STOP has to be out before anything else
+                _stop_draining = true;
+                _addr_start = _ms16();
+                _addr_timeout = (_q_head != NULL && _q_head->timeout_ms) ? _q_head->timeout_ms : _default_timeout;
+            } else {
+                _async_next();
+            }
+            return true;  // Wake a mainline polling t->status or sleeping in wait()
+        };
+
+        void _async_next(void) {
+            if (_q_head != NULL) {
+                _async_start();
+            } else {
+                _async_running = false;
+                _master_release();
+            }
+        };
+
+        /* One step of a wait loop, entered with GIE off: sleeps, enabling interrupts in the same instruction so
+         * no wakeup is lost, or only enables them while a STOP is being set or going out.  Waiting with GIE off on entry
+         * (sr), e.g. in an ISR, runs the handlers from here instead; the address timeout can't fire then, as
+         * the millisecond count doesn't advance.
+         */
+        void _wait_step(unsigned int sr) {
+            if (!(sr & GIE)) {
+                if (txrxifg & (txifgbit | rxifgbit))
+                    isr_handle_txrx();
+                if (stateifg & (UCALIFG | UCNACKIFG | UCSTTIFG | UCSTPIFG))
+                    isr_handle_control();
+            } else if (_stop_pending || _stop_draining) {
+                __bis_SR_register(GIE);
+            } else {
+                __bis_SR_register(LPM0_bits | GIE);
+            }
+        };
+
+        /* Mainline side of the queue, with GIE off - sets a pending STOP, starts the next transaction once the
+         * last one's STOP is out and fails an expired address phase.  A STOP still not out by the deadline (SCL
+         * held low) resets the USCI and fails the transaction that was waiting for it.
+         */
+        boolean _async_poll(void) {
+            if (!_async_running)
+                return false;
+            if (_stop_draining) {
+                if (!(ucbctl1 & UCTXSTP)) {
+                    _stop_draining = false;
+                    _async_next();
+                    return false;
+                }
+                if ((uint16_t)(_ms16() - _addr_start) < _addr_timeout)
+                    return false;
+                _stop_draining = false;
+                ucbctl1 = UCSSEL_2 | UCSWRST;
+                if (_q_head == NULL) {
+                    _async_running = false;
+                    _master_release();
+                } else {
+                    _async_done(TWI_ERROR_TIMEOUT);
+                }
+                return true;
+            }
+            _poll_stop();
+            if (!_addr_expired())
+                return false;
+            _abort_address();
+            _async_done(TWI_ERROR_TIMEOUT);
+            return true;
+        };
+
+        // Blocking transfers take the bus from the queue, waiting for queued transactions to finish
+        void _blocking_begin(void) {
+            unsigned int sr = __get_SR_register();
+
+            while (1) {
+                __bic_SR_register(GIE);
+                _async_poll();
+                if (_q_head == NULL && !_stop_draining)
+                    break;
+                _wait_step(sr);
+            }
+            _blocking = true;
+            __bis_SR_register(sr & GIE);
+        };
+
+        void _blocking_end(void) {
+            unsigned int sr = __get_SR_register();
+
+            __bic_SR_register(GIE);
+            _blocking = false;
+            if (_q_head != NULL && !_async_running)
+                _async_start();  // Transactions queued meanwhile
+            __bis_SR_register(sr & GIE);
+        };
+
+        // Gives up on a transfer stuck before its address was acknowledged; call with GIE off
+        void _abort_address(void) {
+            ucbctl1 = UCSSEL_2 | UCSWRST;
+            _addr_phase = false;
+            _stop_pending = false;
+            twi_state = TWI_IDLE;
+            twi_error = TWI_ERROR_TIMEOUT;
+        };
+
+        /* Runs the transfer set up in _mtx/_mrx.  If the previous one left the bus held this START is a
+         * repeated START, with no UCSWRST cycle in between.  transmit with nothing in _mtx sends just the
+         * address - a probe.
+         */
+        NEVER_INLINE
+        boolean _master_transfer(boolean transmit, uint16_t timeout = 0) {
+            unsigned int sr = __get_SR_register();
+
+            if (!_bus_held) {
+                _blocking_begin();
+                _master_setup();
+            }
+            _held_ack = _bus_held;
+            _bus_held = false;
+            _master_start(transmit, timeout);
+
+            while (1) {
+                __bic_SR_register(GIE);
+                _poll_stop();
+                if (twi_state == TWI_IDLE || twi_error != TWI_ERROR_NONE)
+                    break;
+                if (_addr_expired()) {
+                    _abort_address();
+                    break;
+                }
+                _wait_step(sr);
+            }
+            _held_ack = false;
+            __bis_SR_register(sr & GIE);
+
+            if (!_mstop && twi_error == TWI_ERROR_NONE) {
+                _bus_held = true;  // SCL stays low until the next START
+                return true;
+            }
+
+            while (ucbctl1 & UCTXSTP)  // Wait for STOP condition to complete before resetting bus
+                ;
+            _master_release();
+            _blocking_end();
+
+            return (twi_error == TWI_ERROR_NONE);
+        };
+
     public:
         NEVER_INLINE
         Wire_USCI() {
@@ -72,31 +372,90 @@ class Wire_USCI : public TwoWire_USCI_EXTISR {
             twi_state = TWI_IDLE;
             _clock = 100000UL;  // Default I2C speed = 100KHz
             is_slave = false;
+            _mtx_left = 0;
+            _mrx_left = 0;
+            _bus_held = false;
+            _held_ack = false;
+            _stop_pending = false;
+            _q_head = NULL;
+            _q_tail = NULL;
+            _async_running = false;
+            _blocking = false;
+            _stop_draining = false;
+            _addr_phase = false;
+            _default_timeout = WIRE_USCI_ADDRESS_TIMEOUT;
+            _regs = NULL;
+            _reg_count = 0;
+            _reg_ptr = 0;
+        };
+
+        // Own address matched, from either vector
+        void _slave_start(void) {
+            twi_error = TWI_ERROR_NONE;
+
+            if (ucbctl1 & UCTR) {
+                // Slave TX mode
+                twi_state = TWI_STX;
+                if (_regs == NULL) {
+                    txhead = 0;
+                    txtail = 0;
+
+                    // On Slave Transmit callback
+                    if (stx_callback != NULL)
+                        stx_callback();
+                }
+            } else {
+                // Slave RX mode
+                twi_state = TWI_SRX;
+                rxhead = 0;
+                rxtail = 0;
+                _reg_addressed = false;
+            }
         };
 
         // IRQ matters (and, really, the most important part of the entire codebase)
-        NEVER_INLINE
+        // Deliberately inlinable so USCI_TWOWIRE_ISR_BIND() (usci_isr.h) can inline them into the USCI vectors
         boolean isr_handle_txrx(void) {
             if (txrxifg & txifgbit) {
                 if (twi_state == TWI_MTX) {
                     // MTX
-                    // If there is data to send, then send it; otherwise, stop.
-                    if (txhead < txtail) {
-                        ucbtxbuf = txbuf[txhead++];
+                    // If there is data to send, then send it; otherwise turn around, stop or hold the bus.
+                    if (!(ucbctl1 & UCTXSTT))
+                        _addr_phase = false;  // Not the TXIFG that comes with the START - the address was ACKed
+                    if (_mtx_left) {
+                        ucbtxbuf = *_mtx++;
+                        _mtx_left--;
                         return false;
-                    } else {  // Last byte just sent?
-                        twi_state = TWI_IDLE;
+                    }
+                    txrxifg &= ~txifgbit;  // Last byte just sent
+                    if (_mrx_left) {
+                        // Repeated START as receiver, queued behind the byte still shifting out
+                        ucbctl1 &= ~UCTR;
+                        _addr_phase = true;
+                        _addr_start = _ms16();
+                        ucbctl1 |= UCTXSTT;
+                        twi_state = TWI_MRX;
+                        _stop_pending = (_mrx_left == 1);
+                        return _stop_pending;  // Wake the mainline to poll for the STOP
+                    }
+                    twi_state = TWI_IDLE;
+                    if (_mstop)
                         ucbctl1 |= UCTXSTP;
-                        txrxifg &= ~txifgbit;
-                        return true;  // Signal ISR to wake up CPU
+                    if (_async_running)
+                        return _async_done(TWI_ERROR_NONE);
+                    return true;  // Signal ISR to wake up CPU
+                } else if (!(ucbctl0 & UCMST)) {
+                    // STX - the TX vector outranks the RX one, so isr_handle_control() may not have seen the START yet
+                    if (stateifg & UCSTTIFG) {
+                        stateifg &= ~UCSTTIFG;
+                        _slave_start();
                     }
-                } else if (twi_state == TWI_MRX) {
-                    // STX
-                    // Cool feature idea to add here - "auto answer" mode
-                    if (txhead == txtail)
-                        ucbctl1 |= UCTXNACK;  // No more bytes to send; NACK the bus
-                    else
+                    if (_regs != NULL)
+                        ucbtxbuf = (_reg_ptr < _reg_count) ? _regs[_reg_ptr++] : 0xFF;  // Auto answer
+                    else if (txhead < txtail)
                         ucbtxbuf = txbuf[txhead++];
+                    else
+                        ucbtxbuf = 0xFF;  // Out of data - only the master can end a read
                     return false;
                 }
             }
@@ -104,19 +463,49 @@ class Wire_USCI : public TwoWire_USCI_EXTISR {
             if (txrxifg & rxifgbit) {
                 if (twi_state == TWI_MRX) {
                     // MRX
-                    rxbuf[rxhead++] = ucbrxbuf;
-                    if ( (rxtail - rxhead) == 1 ) {  // Ready to read last byte; inform USCI to send NACK+STOP after
+                    _addr_phase = false;
+                    if (_mrx_left) {
+                        *_mrx++ = ucbrxbuf;
+                        _mrx_left--;
+                    } else {
+                        uint8_t discard = ucbrxbuf;  // Clocked in because a single byte's STOP came late
+                        (void)discard;
+                    }
+                    if (_stop_pending) {
+                        _stop_pending = false;
+                        ucbctl1 |= UCTXSTP;  // After one more byte, dropped above
+                        return false;
+                    }
+                    if (_mrx_left == 1) {  // Ready to read last byte; inform USCI to send NACK+STOP after
                         ucbctl1 |= UCTXSTP;
                         return false;
                     }
-                    if (rxhead >= rxtail) {
-                        rxhead = 0;  // Reset head to 0 in preparation for user code to read the buffer
+                    if (!_mrx_left) {
                         twi_state = TWI_IDLE;
+                        if (_async_running)
+                            return _async_done(TWI_ERROR_NONE);
                         return true;
                     }
                 } else {
                     // SRX
-                    if (rxtail < rxbuf_len) {  // Still room available?
+                    if (_regs != NULL) {
+                        uint8_t c = ucbrxbuf;
+
+                        if (!_reg_addressed) {
+                            _reg_ptr = c;
+                            _reg_addressed = true;
+                        } else if (_reg_ptr < _reg_count) {
+                            uint8_t m = (_reg_writable != NULL) ? _reg_writable[_reg_ptr] : 0;
+                            if (m) {
+                                _regs[_reg_ptr] = (_regs[_reg_ptr] & ~m) | (c & m);
+                                if (_reg_dirty != NULL)
+                                    _reg_dirty[_reg_ptr >> 3] |= _bitvect[_reg_ptr & 7];
+                            }
+                            _reg_ptr++;
+                        } else {
+                            ucbctl1 |= UCTXNACK;  // Past the last register
+                        }
+                    } else if (rxtail < rxbuf_len) {  // Still room available?
                         rxbuf[rxtail++] = ucbrxbuf;
                     } else {
                         ucbctl1 |= UCTXNACK;  // No; send NACK and ignore byte.
@@ -126,22 +515,36 @@ class Wire_USCI : public TwoWire_USCI_EXTISR {
             return false;
         };
 
-        NEVER_INLINE
         boolean isr_handle_control(void) {
             // Arbitration lost (master mode)
             if (stateifg & UCALIFG) {
                 stateifg &= ~UCALIFG;
+                _stop_pending = false;
                 twi_state = TWI_IDLE;
                 twi_error = TWI_ERROR_BUS_BUSY;
+                if (_async_running)
+                    return _async_done(TWI_ERROR_BUS_BUSY);
                 return true;
             }
 
             // NACK received
             if (stateifg & UCNACKIFG) {
                 stateifg &= ~UCNACKIFG;
-                if (twi_state == TWI_MTX || twi_state == TWI_MRX) {
-                    // Could be data NACK or address NACK, hard to tell.
-                    twi_error = TWI_ERROR_NACK;
+                if (ucbctl0 & UCMST) {
+                    // Including a probe, which is already TWI_IDLE while its STOP goes out
+                    if (_held_ack && (ucbctl1 & UCTXSTT)) {
+                        twi_error = TWI_ERROR_NACK;  // The held write's last byte; drop the repeated START for the STOP
+                        ucbctl1 &= ~UCTXSTT;
+                    } else {
+                        twi_error = _nack_error();
+                    }
+                    _held_ack = false;
+                    _addr_phase = false;
+                    _stop_pending = false;
+                    ucbctl1 |= UCTXSTP;  // The master has to release the bus
+                    twi_state = TWI_IDLE;
+                    if (_async_running)
+                        return _async_done(twi_error);
                 }
                 twi_state = TWI_IDLE;
                 return true;
@@ -150,35 +553,14 @@ class Wire_USCI : public TwoWire_USCI_EXTISR {
             // START condition
             if (stateifg & UCSTTIFG) {
                 stateifg &= ~UCSTTIFG;
-                twi_error = TWI_ERROR_NONE;
-
-                if (ucbctl1 & UCTR) {
-                    // Slave TX mode
-                    twi_state = TWI_STX;
-                    txhead = 0;
-                    txtail = 0;
-                    
-                    // On Slave Transmit callback
-                    if (stx_callback != NULL)
-                        stx_callback();
-                    // No data to send? NACK.
-                    if (txtail == 0) {
-                        ucbctl1 |= UCTXNACK;
-                        twi_state = TWI_IDLE;
-                    }
-                } else {
-                    // Slave RX mode
-                    twi_state = TWI_SRX;
-                    rxhead = 0;
-                    rxtail = 0;
-                }
+                _slave_start();
             }
 
             // STOP condition
             if (stateifg & UCSTPIFG) {
                 stateifg &= ~UCSTPIFG;
 
-                if (twi_state == TWI_SRX) {
+                if (twi_state == TWI_SRX && _regs == NULL) {
                     // Completion of slave RX - Run callback to process data
                     // rxtail has total length, rxhead should be 0...
                     if (srx_callback != NULL && rxhead < rxtail) {
@@ -252,6 +634,10 @@ class Wire_USCI : public TwoWire_USCI_EXTISR {
         NEVER_INLINE
         void end(void) {
             ucbctl1 |= UCSWRST;
+            _q_head = NULL;  // Abandon queued transactions
+            _q_tail = NULL;
+            _async_running = false;
+            _stop_draining = false;
             twi_state = TWI_IDLE;
             twi_error = TWI_ERROR_NONE;
             set_pxsel(pxsel, pxsel2, PORT_SELECTION_NONE, pxbits);
@@ -275,6 +661,41 @@ class Wire_USCI : public TwoWire_USCI_EXTISR {
             stx_callback = cb;
         };
 
+        /* Register-map slave ("auto answer") - the ISRs serve the master from regs[count] with no callbacks.
+         * The first byte of each write sets the register pointer, the rest go to regs[pointer++] through that
+         * register's writable bit mask (writable NULL = all read-only) and set its bit in dirty, an optional
+         * bitmap of (count + 7) / 8 bytes.  Reads return regs[pointer++], 0xFF past the end.  The pointer
+         * carries across a repeated START, so pointer-write-then-read works.  Every STOP wakes the mainline.
+         * regs NULL goes back to onRequest()/onReceive().
+         */
+        NEVER_INLINE
+        void setRegisterMap(volatile uint8_t *regs, size_t count, const uint8_t *writable = NULL, volatile uint8_t *dirty = NULL) {
+            unsigned int sr = __get_SR_register();
+
+            __bic_SR_register(GIE);
+            _regs = regs;
+            _reg_count = (regs != NULL) ? count : 0;
+            _reg_writable = writable;
+            _reg_dirty = dirty;
+            _reg_ptr = 0;
+            __bis_SR_register(sr & GIE);
+        };
+
+        // Test-and-clear of reg's dirty bit
+        NEVER_INLINE
+        boolean registerDirty(uint8_t reg) {
+            unsigned int sr = __get_SR_register();
+            boolean dirty;
+
+            if (_reg_dirty == NULL || reg >= _reg_count)
+                return false;
+            __bic_SR_register(GIE);
+            dirty = (_reg_dirty[reg >> 3] & _bitvect[reg & 7]) != 0;
+            _reg_dirty[reg >> 3] &= ~_bitvect[reg & 7];
+            __bis_SR_register(sr & GIE);
+            return dirty;
+        };
+
         // Buffer usage matters
         int available(void) { return rxtail-rxhead; };
         void flush(void) { rxhead = rxtail; };
@@ -293,6 +714,22 @@ class Wire_USCI : public TwoWire_USCI_EXTISR {
             return rxbuf[rxhead];
         };
 
+        // Bulk RX for Stream::readBytes()/readBytesUntil() - rxbuf is linear, so this is a single memchr/memcpy
+        NEVER_INLINE
+        size_t readBuffered(uint8_t *buf, size_t len, int terminator = -1) {
+            uint16_t head = rxhead;
+            size_t span = (rxtail > head) ? (size_t)(rxtail - head) : 0;
+            const uint8_t *p = (const uint8_t *)&rxbuf[head], *t;
+
+            if (span > len)
+                span = len;
+            if (terminator >= 0 && (t = (const uint8_t *)memchr(p, terminator, span)) != NULL)
+                span = (t - p) + 1;
+            memcpy(buf, p, span);
+            rxhead = head + span;
+            return span;
+        };
+
         NEVER_INLINE
         size_t write(uint8_t c) {
             if (txtail >= txbuf_len)
@@ -301,14 +738,22 @@ class Wire_USCI : public TwoWire_USCI_EXTISR {
             return 1;
         };
 
+        // One memcpy instead of a virtual write(uint8_t) per byte; stops where txbuf is full
+        NEVER_INLINE
+        size_t write(const uint8_t *buf, size_t len) {
+            size_t room = txbuf_len - txtail;
+
+            if (len > room)
+                len = room;
+            memcpy((uint8_t *)&txbuf[txtail], buf, len);
+            txtail += len;
+            return len;
+        };
+
         // Connection management
         NEVER_INLINE
         void beginTransmission(int i2caddr) {
-            i2csa = i2caddr & 0x1FF;
-            if (i2caddr & 0x180)
-                ucbctl0 |= UCSLA10;
-            else
-                ucbctl0 &= ~UCSLA10;
+            _set_slave_address(i2caddr);
             txhead = 0;
             txtail = 0;
             twi_state = TWI_IDLE;
@@ -317,124 +762,127 @@ class Wire_USCI : public TwoWire_USCI_EXTISR {
 
         void beginTransmission(uint8_t i2caddr) { beginTransmission((int) i2caddr); };
 
+        /* With stop false this returns once the last byte is in the shifter; its ACK is only clocked when the
+         * next transfer's repeated START is set, so a NACK of it fails that next call with TWI_ERROR_NACK
+         * (instead of an address NACK) and ends the held write with a STOP.
+         */
         NEVER_INLINE
-        boolean endTransmission(void) {
-            if (txhead >= txtail)
-                return false;  // Nothing to send!
-
-            ucbctl1 |= UCSWRST;
-            ucbctl0 |= UCMST;
-            ucbctl1 = UCSSEL_2 | UCTR | UCSWRST;
-            ucbctl1 &= ~UCSWRST;
-            twi_state = TWI_MTX;
-            twi_error = TWI_ERROR_NONE;
-
-            stateie |= UCSTTIE | UCSTPIE | UCALIE | UCNACKIE;
-            txrxie |= txiebit | rxiebit;
-
-            // Check for timeout waiting for client to respond
-            uint32_t mstart = millis();
-            ucbctl1 |= UCTXSTT;  // Initiate START condition
-
-            while ( (ucbctl1 & UCTXSTT) && (millis() - mstart) < 50 )  // Wait until START+ADDR is finished sending...
-                ;
-            if ( (millis() - mstart) > 49 ) {  // Address NACK or fault in slave?
-                ucbctl1 = UCSSEL_2 | UCSWRST;
-                twi_state = TWI_IDLE;
-                twi_error = TWI_ERROR_MTX_ADDR_NACK;
-                if (is_slave) {
-                    ucbctl0 &= ~UCMST;
-                    ucbctl1 &= ~UCSWRST;  // Restore slave mode functionality
-                }
-                return false;
-            }
-
-            while (twi_state != TWI_IDLE && twi_error == TWI_ERROR_NONE)
-                LPM0;
-
-            while (ucbctl1 & UCTXSTP)  // Wait for STOP condition to complete before resetting bus
-                ;
-
-            if (is_slave) {
-                ucbctl1 |= UCSWRST;
-                ucbctl0 &= ~UCMST;
-                ucbctl1 &= ~UCSWRST;
-            } else {
-                ucbctl1 = UCSSEL_2 | UCSWRST;
-                stateie &= ~(UCSTTIE | UCSTPIE | UCALIE | UCNACKIE);
-                txrxie &= ~(txiebit | rxiebit);
-            }
-
-            if (twi_error != TWI_ERROR_NONE)
-                return false;
-            return true;
+        boolean endTransmission(boolean stop) {
+            _mtx = (const uint8_t *)&txbuf[txhead];
+            _mtx_left = txtail - txhead;  // Nothing written = address probe, e.g. for a bus scan
+            _mrx_left = 0;
+            _mstop = stop;
+            return _master_transfer(true);
         };
 
+        boolean endTransmission(void) { return endTransmission(true); };
+
         NEVER_INLINE
         int requestFrom(int addr, int len) {
             if (len < 1 || (size_t)len > rxbuf_len)
                 return 0;  // Nothing to do!
 
-            rxhead = 0;
+            if (!requestFrom(addr, (uint8_t *)rxbuf, (size_t)len))
+                return 0;
             rxtail = len;
+            return rxtail;
+        };
 
-            ucbctl1 |= UCSWRST;
-            i2csa = addr & 0x1FF;
-            if (addr & 0x180)
-                ucbctl0 |= UCSLA10;
-            else
-                ucbctl0 &= ~UCSLA10;
-            ucbctl0 |= UCMST;
-            ucbctl1 = UCSSEL_2 | UCSWRST;
-            ucbctl1 &= ~UCSWRST;
+        // The ISR stores straight into dst, so reads can be longer than rxbuf_len
+        NEVER_INLINE
+        size_t requestFrom(int addr, uint8_t *dst, size_t len, uint16_t timeout_ms = 0) {
+            if (!len)
+                return 0;
 
-            twi_state = TWI_MRX;
-            twi_error = TWI_ERROR_NONE;
+            _set_slave_address(addr);
+            rxhead = 0;
+            rxtail = 0;
+            _mtx_left = 0;
+            _mrx = dst;
+            _mrx_left = len;
+            _mstop = true;
+            return _master_transfer(false, timeout_ms) ? len : 0;
+        };
 
-            stateie |= UCSTTIE | UCSTPIE | UCALIE | UCNACKIE;
-            txrxie |= txiebit | rxiebit;
+        // One START, the write, a repeated START and the read straight into rx; the internal buffers aren't used
+        NEVER_INLINE
+        boolean writeThenRead(int addr, const uint8_t *tx, size_t txlen, uint8_t *rx, size_t rxlen, uint16_t timeout_ms = 0) {
+            if (!txlen && !rxlen)
+                return false;
 
-            // Check for timeout waiting for client to respond
-            uint32_t mstart = millis();
-            ucbctl1 |= UCTXSTT;  // Initiate START condition
+            _set_slave_address(addr);
+            rxhead = 0;
+            rxtail = 0;
+            _mtx = tx;
+            _mtx_left = txlen;
+            _mrx = rx;
+            _mrx_left = rxlen;
+            _mstop = true;
+            return _master_transfer(txlen != 0, timeout_ms);
+        };
 
-            while ( (ucbctl1 & UCTXSTT) && (millis() - mstart) < 50 )  // Wait until START+ADDR is finished sending...
-                ;
-            if ( (millis() - mstart) > 49 ) {  // Address NACK or fault in slave?
-                ucbctl1 = UCSSEL_2 | UCSWRST;
-                twi_state = TWI_IDLE;
-                twi_error = TWI_ERROR_MRX_ADDR_NACK;
-                if (is_slave) {
-                    ucbctl0 &= ~UCMST;
-                    ucbctl1 &= ~UCSWRST;  // Restore slave mode functionality
-                }
-                return 0;
-            }
+        /* Never blocks - the queue is a list through the descriptors themselves.  Back-to-back transactions
+         * are started from the ISR that finished the previous one if its STOP is already out; if not (up to one
+         * byte time after a write or a NACK), wait() or checkTimeout() starts the next one once it is, so call
+         * one of them while the queue is busy.  They also set a single-byte read's STOP; with neither running
+         * it goes out one (dropped) byte late.
+         */
+        NEVER_INLINE
+        boolean queueTransaction(struct twowire_transaction *t) {
+            unsigned int sr;
 
-            if (len == 1)
-                ucbctl1 |= UCTXSTP;  // STOP needs to be sent right away if it's just 1 byte!
+            if (t == NULL || (!t->txlen && !t->rxlen))
+                return false;
+            t->status = TWOWIRE_PENDING;
+            t->next = NULL;
 
-            while (twi_state != TWI_IDLE && twi_error == TWI_ERROR_NONE)
-                LPM0;
+            sr = __get_SR_register();
+            __bic_SR_register(GIE);
+            if (_q_tail != NULL)
+                _q_tail->next = t;
+            else
+                _q_head = t;
+            _q_tail = t;
+            if (!_async_running && !_blocking)
+                _async_start();
+            __bis_SR_register(sr & GIE);
+            return true;
+        };
 
-            while (ucbctl1 & UCTXSTP)  // Wait for STOP condition to complete before resetting bus
-                ;
+        boolean isBusy(void) { return _q_head != NULL || _stop_draining; };
 
-            if (is_slave) {
-                ucbctl1 |= UCSWRST;
-                ucbctl0 &= ~UCMST;
-                ucbctl1 &= ~UCSWRST;
-            } else {
-                ucbctl1 = UCSSEL_2 | UCSWRST;
-                stateie &= ~(UCSTTIE | UCSTPIE | UCALIE | UCNACKIE);
-                txrxie &= ~(txiebit | rxiebit);
+        NEVER_INLINE
+        void wait(void) {
+            unsigned int sr = __get_SR_register();
+
+            while (1) {
+                __bic_SR_register(GIE);
+                _async_poll();
+                if (_q_head == NULL && !_stop_draining)
+                    break;
+                _wait_step(sr);
             }
+            __bis_SR_register(sr & GIE);
+        };
 
-            if (twi_error != TWI_ERROR_NONE)
-                return 0;
-            return rxtail;
+        /* Queued transactions have no mainline waiting on them - call this now and then (wait() does) to
+         * fail one stuck in its START/address phase past its timeout, and move on to the next.  It also sets
+         * a pending single-byte read's STOP, and starts the next transaction once the last one's STOP is out.
+         */
+        NEVER_INLINE
+        boolean checkTimeout(void) {
+            unsigned int sr = __get_SR_register();
+            boolean expired;
+
+            __bic_SR_register(GIE);
+            expired = _async_poll();
+            __bis_SR_register(sr & GIE);
+            return expired;
         };
 
+        // START/address phase timeout for blocking calls without a timeout_ms, and queued ones with timeout_ms 0
+        void setAddressTimeout(uint16_t ms) { _default_timeout = ms ? ms : 1; };
+
         uint8_t requestFrom(uint8_t addr, uint8_t len) { return requestFrom((int) addr, (int) len); };
 };
 
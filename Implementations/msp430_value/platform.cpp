@@ -183,6 +183,21 @@ void digitalWrite(int pin, uint8_t value)
         *pxout &= ~pxbit;
 }
 
+// Resolve a pin once, then drive it with *port |= mask / *port &= ~mask instead of digitalWrite()
+volatile uint8_t * portOutputRegister(int pin)
+{
+    if (pin < 1 || pin > 32)
+        return NULL;
+    return _msp430_get_port(pin, PxOUT);
+}
+
+uint8_t digitalPinToBitMask(int pin)
+{
+    if (pin < 1 || pin > 32)
+        return 0;
+    return _bitvect[(pin - 1) % 8];
+}
+
 int digitalRead(int pin)
 {
     if (pin < 1 || pin > 32)
@@ -322,7 +337,7 @@ void detachInterrupt(int pin)
     return;
 }
 
-// maskInterrupt and unmaskInterrupt are used by SPI_USCI for usingInterrupt() Transaction support.
+// maskInterrupt(s) and unmaskInterrupt(s) are used by SPI_USCI for usingInterrupt() Transaction support.
 void maskInterrupt(int pin)
 {
     if (pin > 16)
@@ -355,6 +370,28 @@ void unmaskInterrupt(int pin)
         P2IE |= pxbit;
 }
 
+// Pin sets, bit (pin - 1) - one bic.b/bis.b per port, so these need no GIE protection
+void maskInterrupts(uint16_t pins)
+{
+    P1IE &= ~(uint8_t)pins;
+    P2IE &= ~(uint8_t)(pins >> 8);
+}
+
+void unmaskInterrupts(uint16_t pins)
+{
+    uint8_t p1 = 0, p2 = 0;
+    int i;
+
+    for (i = 0; i < 8; i++) {
+        if (intVect_P1[i] != NULL)
+            p1 |= _bitvect[i];
+        if (intVect_P2[i] != NULL)
+            p2 |= _bitvect[i];
+    }
+    P1IE |= (uint8_t)pins & p1;
+    P2IE |= (uint8_t)(pins >> 8) & p2;
+}
+
 __attribute__((interrupt(PORT1_VECTOR)))
 void P1_ISR(void)
 {
@@ -15,6 +15,7 @@
  * definition of F_CPU for libraries that require it
  * function prototypes for interrupts() and noInterrupts() to enable/disable global IRQs
  * function prototypes for pinMode, digitalWrite, digitalRead, analogRead, analogWrite, analogReference, analogFrequency
+ * function prototypes for portOutputRegister and digitalPinToBitMask (direct port access, e.g. SPIDevice chip selects)
  * function prototypes for delay, delayMicroseconds, optionally sleep, suspend, wakeup
  * function prototypes for attachInterrupt, detachInterrupt
  * function prototypes for micros() and millis()
@@ -92,6 +93,8 @@ static const int P4_7 = 32;
 void pinMode(int, int);
 void digitalWrite(int, uint8_t);
 int digitalRead(int);
+volatile uint8_t * portOutputRegister(int);
+uint8_t digitalPinToBitMask(int);
 void analogWrite(int, int);
 void analogFrequency(uint16_t);
 
@@ -105,6 +108,8 @@ void attachInterrupt(int, void (*)(void), int mode);
 void detachInterrupt(int);
 void maskInterrupt(int);
 void unmaskInterrupt(int);
+void maskInterrupts(uint16_t);
+void unmaskInterrupts(uint16_t);
 unsigned long micros();
 unsigned long millis();
 extern volatile uint32_t _sys_millis;
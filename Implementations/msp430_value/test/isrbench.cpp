@@ -0,0 +1,68 @@
+#include <AbstractWiring.h>
+#include <UART_USCI.h>
+
+/* USCIAB0 RX vector entry-to-exit time, in MCLK cycles counted by Timer_A.
+ *
+ * The RX interrupt is raised in software by setting UCA0RXIFG with GIE off; opening GIE lets exactly one
+ * ISR run, and the same sequence without the flag set is subtracted out.  Built twice by the Makefile:
+ * isrbench.elf uses the default vtable dispatch, isrbench_static.elf binds Serial with USCI_UART_ISR_BIND() and
+ * USCI_ISR_BIND_VECTORS().
+ */
+
+#define BENCH_RUNS 64
+
+UART_USCI <0, UCA0CTL0, UCA0CTL1, UCA0MCTL, UCA0ABCTL, UCA0BR0, UCA0BR1, UCA0STAT, UCA0TXBUF, UCA0RXBUF, IE2, UCA0TXIE, UCA0RXIE, 32, 16, P1SEL, P1SEL2, PORT_SELECTION_0_AND_1, BIT1|BIT2> Serial;
+#ifdef ISRBENCH_STATIC
+USCI_UART_ISR_BIND(0, Serial)
+USCI_ISR_BIND_VECTORS()
+#endif
+
+NEVER_INLINE
+uint16_t time_rx_isr(boolean raise)
+{
+	uint16_t start = TA0R;
+	if (raise)
+		IFG2 |= UCA0RXIFG;
+	__bis_SR_register(GIE);
+	__bic_SR_register(GIE);
+	return TA0R - start;
+}
+
+int main()
+{
+	unsigned int i;
+	uint32_t t_isr, t_base;
+
+	WDTCTL = WDTPW | WDTHOLD;
+	DCOCTL = CALDCO_16MHZ;
+	BCSCTL1 = CALBC1_16MHZ;
+
+	sysinit(16000000UL);
+	Serial.begin(9600);
+
+	TA0CTL = TASSEL_2 | MC_2 | TACLR;  // SMCLK, continuous mode
+
+	while(1) {
+		t_isr = 0;
+		t_base = 0;
+		__bic_SR_register(GIE);
+		IE1 &= ~WDTIE;  // Keep the WDT tick out of the measurement
+		for (i = 0; i < BENCH_RUNS; i++) {
+			t_base += time_rx_isr(false);
+			t_isr += time_rx_isr(true);
+			Serial.read();
+		}
+		IE1 |= WDTIE;
+		__bis_SR_register(GIE);
+
+#ifdef ISRBENCH_STATIC
+		Serial.print("static bind RX ISR: ");
+#else
+		Serial.print("vtable RX ISR: ");
+#endif
+		Serial.print((t_isr - t_base) / BENCH_RUNS);
+		Serial.println(" cycles");
+		delay(1000);
+	}
+	return 0;
+}
@@ -0,0 +1,73 @@
+/* Host-side bit-level model check of usci_spi_pack9() (SPI_USCI_Pack9.h) - no MSP430 needed:
+ *
+ *   g++ -std=gnu++14 -I.. -I../../../AbstractWiring pack9_host.cpp -o pack9_host && ./pack9_host
+ *
+ * For random groups of 8 words, in both bit orders, the bits the USCI shifter puts on the wire for the 9
+ * packed bytes must be the bits 8 separate transfer9() calls put there.  Words with stray bits above bit 8
+ * are included; those bits must be ignored.
+ */
+
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+#include <assert.h>
+
+// Just enough of AbstractWiring.h for SPI_USCI_Pack9.h
+#define ABSTRACTWIRING_H
+typedef uint8_t boolean;
+
+#include <SPI_USCI_Pack9.h>
+
+#define GROUPS 100000
+
+// Wire bits of 8 transfer9() calls: bit 8 first then bits 7-0 (MSB first), or bits 0-8 (LSB first)
+static void wire_words(const uint16_t *w, boolean msbfirst, uint8_t *bits)
+{
+	for (unsigned int i = 0; i < 8; i++)
+		for (unsigned int b = 0; b < 9; b++)
+			*bits++ = (w[i] >> (msbfirst ? 8 - b : b)) & 1;
+}
+
+// Wire bits of the USCI shifting out 8-bit characters in the given order
+static void wire_bytes(const uint8_t *p, unsigned int n, boolean msbfirst, uint8_t *bits)
+{
+	for (unsigned int i = 0; i < n; i++)
+		for (unsigned int b = 0; b < 8; b++)
+			*bits++ = (p[i] >> (msbfirst ? 7 - b : b)) & 1;
+}
+
+// Fixed-seed LCG, so a failure reproduces
+static uint32_t lcg_state = 1;
+
+static uint16_t lcg16(void)
+{
+	lcg_state = lcg_state * 1103515245UL + 12345UL;
+	return (uint16_t)(lcg_state >> 16);
+}
+
+int main()
+{
+	uint16_t words[8];
+	uint8_t packed[9], expect[72], actual[72];
+	unsigned long g;
+	unsigned int i;
+	int msbfirst;
+
+	for (g = 0; g < GROUPS; g++) {
+		for (i = 0; i < 8; i++)
+			words[i] = lcg16() & ((g & 1) ? 0x01FF : 0xFFFF);
+		for (msbfirst = 0; msbfirst < 2; msbfirst++) {
+			memset(packed, 0xA5, sizeof(packed));
+			usci_spi_pack9(words, packed, msbfirst);
+			wire_words(words, msbfirst, expect);
+			wire_bytes(packed, sizeof(packed), msbfirst, actual);
+			if (memcmp(expect, actual, sizeof(expect))) {
+				printf("group %lu, %s first: wire bits differ\n", g, msbfirst ? "MSB" : "LSB");
+				return 1;
+			}
+		}
+	}
+
+	printf("usci_spi_pack9: %u groups OK in both bit orders\n", GROUPS);
+	return 0;
+}
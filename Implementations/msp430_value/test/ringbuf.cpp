@@ -0,0 +1,86 @@
+#include <AbstractWiring.h>
+#include <RingBuffer.h>
+#include <UART_USCI.h>
+
+/* Per-byte push+pop cost of the modulo-indexed ring UART_USCI used before RingBuffer, versus RingBuffer's
+ * masked free-running indices.  Cycles are counted with Timer_A on SMCLK (= MCLK) and reported over Serial.
+ *
+ * Both rings have the same capacity and inlined push/pop, and both are driven by the same loop (bench<>()),
+ * so the numbers differ only in the index arithmetic.  The old drivers accepted any size, where every index
+ * wrap needs a real division on this CPU; at the power-of-two size RingBuffer requires, the compiler turns
+ * the legacy modulo into a mask too, so this is the best case for the legacy ring.
+ */
+
+#define BENCH_BYTES 128
+#define RING_BYTES 64
+
+UART_USCI <0, UCA0CTL0, UCA0CTL1, UCA0MCTL, UCA0ABCTL, UCA0BR0, UCA0BR1, UCA0STAT, UCA0TXBUF, UCA0RXBUF, IE2, UCA0TXIE, UCA0RXIE, 32, 16, P1SEL, P1SEL2, PORT_SELECTION_0_AND_1, BIT1|BIT2> Serial;
+
+struct legacy_ring {
+	volatile uint8_t buf[RING_BYTES];
+	volatile unsigned int head, tail;
+
+	boolean push(uint8_t c) {
+		unsigned int i = (head + 1) % sizeof(buf);
+		if (i == tail)
+			return false;
+		buf[head] = c;
+		head = i;
+		return true;
+	};
+
+	int pop(void) {
+		if (head == tail)
+			return -1;
+		uint8_t c = buf[tail];
+		tail = (unsigned int)(tail + 1) % sizeof(buf);
+		return c;
+	};
+};
+
+legacy_ring legacy;
+RingBuffer<uint8_t, RING_BYTES> ring;
+
+// The ring is never full or empty here, so no caller-side checks are needed for either ring
+template <typename R>
+NEVER_INLINE
+uint16_t bench(R & r)
+{
+	unsigned int i;
+	uint16_t start = TA0R;
+	for (i = 0; i < BENCH_BYTES; i++) {
+		r.push((uint8_t)i);
+		r.pop();
+	}
+	return TA0R - start;
+}
+
+int main()
+{
+	uint16_t t_legacy, t_ring;
+
+	WDTCTL = WDTPW | WDTHOLD;
+	DCOCTL = CALDCO_16MHZ;
+	BCSCTL1 = CALBC1_16MHZ;
+
+	sysinit(16000000UL);
+	Serial.begin(9600);
+
+	TA0CTL = TASSEL_2 | MC_2 | TACLR;  // SMCLK, continuous mode
+
+	while(1) {
+		__bic_SR_register(GIE);  // Keep the WDT/USCI ISRs out of the measurement
+		t_legacy = bench(legacy);
+		t_ring = bench(ring);
+		__bis_SR_register(GIE);
+
+		Serial.print("legacy % ring: ");
+		Serial.print(t_legacy / BENCH_BYTES);
+		Serial.println(" cycles/byte");
+		Serial.print("RingBuffer:    ");
+		Serial.print(t_ring / BENCH_BYTES);
+		Serial.println(" cycles/byte");
+		delay(1000);
+	}
+	return 0;
+}
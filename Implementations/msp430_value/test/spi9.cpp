@@ -0,0 +1,40 @@
+#include <AbstractWiring.h>
+#include <SPI_USCI.h>
+
+/* 3-wire (9-bit) LCD controller init - bit 8 of each word is D/C.  transfer9(words, n) sends each group of
+ * 8 words packed into 9 bytes through the 8-bit write() path; only the last n % 8 words (3 here) go through
+ * the bit-banged 9th bit.  CS on P2.0.
+ *
+ * SPI_USCI's transfer9() overloads are part of the extended API, so this sketch must be built with
+ * -DSPI_ENABLE_EXTENDED_API (the Makefile does); without it the SPIClass default would send nothing.
+ */
+
+#ifndef SPI_ENABLE_EXTENDED_API
+#error "spi9.cpp needs -DSPI_ENABLE_EXTENDED_API for SPI_USCI::transfer9()"
+#endif
+
+SPI_USCI<USCI_SPI_B0,UCB0CTL0,UCB0CTL1,UCB0BR0,UCB0BR1,UCB0STAT,UCB0TXBUF,UCB0RXBUF,IFG2,UCB0TXIFG,UCB0RXIFG,IE2,UCB0RXIE,P1DIR,P1OUT,P1SEL,P1SEL2,BIT5,PORT_SELECTION_0_AND_1,P1DIR,P1OUT,P1SEL,P1SEL2,BIT7,PORT_SELECTION_0_AND_1,P1DIR,P1IN,P1SEL,P1SEL2,BIT6,PORT_SELECTION_0_AND_1> SPI;
+
+const uint16_t lcd_init[11] = { 0x011, 0x03A, 0x105, 0x036, 0x1C8, 0x02A, 0x100, 0x100, 0x100, 0x17F, 0x029 };
+
+int main()
+{
+	WDTCTL = WDTPW | WDTHOLD;
+	DCOCTL = CALDCO_16MHZ;
+	BCSCTL1 = CALBC1_16MHZ;
+
+	sysinit(16000000UL);
+	SPI.begin();
+	pinMode(P2_0, OUTPUT);
+	digitalWrite(P2_0, HIGH);
+
+	while(1) {
+		SPI.beginTransaction(usci_spi_settings(4000000UL, MSBFIRST, SPI_MODE0));
+		digitalWrite(P2_0, LOW);
+		SPI.transfer9(lcd_init, 11);
+		digitalWrite(P2_0, HIGH);
+		SPI.endTransaction();
+		delay(500);
+	}
+	return 0;
+}
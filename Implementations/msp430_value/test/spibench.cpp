@@ -0,0 +1,83 @@
+#include <AbstractWiring.h>
+#include <SPI_USCI.h>
+#include <UART_USCI.h>
+
+/* 512-byte SPI transfer time (e.g. a display flush) in MCLK cycles, counted with Timer_A and reported over Serial.
+ *
+ * Compares a transfer(uint8_t) loop, which waits on UCBUSY before and after every byte, against the buffer API,
+ * which keeps UCB0TXBUF loaded so SCLK never stops between bytes.  At SCLK = MCLK/2 the ideal is 16 cycles/byte.
+ */
+
+#define BENCH_BYTES 512
+
+SPI_USCI<USCI_SPI_B0,UCB0CTL0,UCB0CTL1,UCB0BR0,UCB0BR1,UCB0STAT,UCB0TXBUF,UCB0RXBUF,IFG2,UCB0TXIFG,UCB0RXIFG,IE2,UCB0RXIE,P1DIR,P1OUT,P1SEL,P1SEL2,BIT5,PORT_SELECTION_0_AND_1,P1DIR,P1OUT,P1SEL,P1SEL2,BIT7,PORT_SELECTION_0_AND_1,P1DIR,P1IN,P1SEL,P1SEL2,BIT6,PORT_SELECTION_0_AND_1> SPI;
+UART_USCI <0, UCA0CTL0, UCA0CTL1, UCA0MCTL, UCA0ABCTL, UCA0BR0, UCA0BR1, UCA0STAT, UCA0TXBUF, UCA0RXBUF, IE2, UCA0TXIE, UCA0RXIE, 32, 16, P1SEL, P1SEL2, PORT_SELECTION_0_AND_1, BIT1|BIT2> Serial;
+
+uint8_t buf[BENCH_BYTES];
+
+NEVER_INLINE
+uint16_t bench_bytewise(void)
+{
+	unsigned int i;
+	uint16_t start = TA0R;
+	for (i = 0; i < BENCH_BYTES; i++)
+		buf[i] = SPI.transfer(buf[i]);
+	return TA0R - start;
+}
+
+NEVER_INLINE
+uint16_t bench_transfer(void)
+{
+	uint16_t start = TA0R;
+	SPI.transfer(buf, BENCH_BYTES);
+	return TA0R - start;
+}
+
+NEVER_INLINE
+uint16_t bench_write(void)
+{
+	uint16_t start = TA0R;
+	SPI.write(buf, BENCH_BYTES);
+	return TA0R - start;
+}
+
+void report(const char *name, uint16_t cycles)
+{
+	Serial.print(name);
+	Serial.print(cycles);
+	Serial.print(" cycles, ");
+	Serial.print(cycles / BENCH_BYTES);
+	Serial.println(" cycles/byte");
+}
+
+int main()
+{
+	uint16_t t_byte, t_xfer, t_write;
+
+	WDTCTL = WDTPW | WDTHOLD;
+	DCOCTL = CALDCO_16MHZ;
+	BCSCTL1 = CALBC1_16MHZ;
+
+	sysinit(16000000UL);
+	Serial.begin(9600);
+	SPI.begin();
+	SPI.beginTransaction(SPISettings(8000000UL, MSBFIRST, SPI_MODE0));
+
+	TA0CTL = TASSEL_2 | MC_2 | TACLR;  // SMCLK, continuous mode
+
+	while(1) {
+		__bic_SR_register(GIE);
+		IE1 &= ~WDTIE;  // Keep the WDT tick out of the measurement
+		t_byte = bench_bytewise();
+		t_xfer = bench_transfer();
+		t_write = bench_write();
+		IE1 |= WDTIE;
+		__bis_SR_register(GIE);
+
+		report("transfer(uint8_t) loop: ", t_byte);
+		report("transfer(buf, n): ", t_xfer);
+		report("write(buf, n): ", t_write);
+		delay(1000);
+	}
+	return 0;
+}
@@ -0,0 +1,100 @@
+#include <AbstractWiring.h>
+#include <UART_USCI.h>
+#include <SPI_USCI.h>
+
+/* Deferred transactions - Timer_A0 samples an SPI ADC (CS on P2.1) at 40Hz from its ISR with
+ * requestTransaction(), while the main loop holds the bus for 10ms at a time talking to another device (CS on
+ * P2.0).  Requests that find the bus busy are queued and run by the main loop's endTransaction().  The button
+ * on pin 4 is registered with usingInterrupt(), so it's held off during transactions; maskedMicros() reports
+ * the longest it was held off.
+ */
+
+UART_USCI <0, UCA0CTL0, UCA0CTL1, UCA0MCTL, UCA0ABCTL, UCA0BR0, UCA0BR1, UCA0STAT, UCA0TXBUF, UCA0RXBUF, IE2, UCA0TXIE, UCA0RXIE, 16, 2, P1SEL, P1SEL2, PORT_SELECTION_0_AND_1, BIT1|BIT2> Serial;
+SPI_USCI<USCI_SPI_B0,UCB0CTL0,UCB0CTL1,UCB0BR0,UCB0BR1,UCB0STAT,UCB0TXBUF,UCB0RXBUF,IFG2,UCB0TXIFG,UCB0RXIFG,IE2,UCB0RXIE,P1DIR,P1OUT,P1SEL,P1SEL2,BIT5,PORT_SELECTION_0_AND_1,P1DIR,P1OUT,P1SEL,P1SEL2,BIT7,PORT_SELECTION_0_AND_1,P1DIR,P1IN,P1SEL,P1SEL2,BIT6,PORT_SELECTION_0_AND_1> SPI;
+
+volatile boolean sample_ran;
+volatile unsigned int immediate = 0, deferred = 0, dropped = 0, presses = 0;
+volatile uint16_t sample;
+
+void sampleAdc(void *arg)
+{
+	digitalWrite(P2_1, LOW);
+	sample = (SPI.transfer(0x00) << 8) & 0x0F00;
+	sample |= SPI.transfer(0x00);
+	digitalWrite(P2_1, HIGH);
+	sample_ran = true;
+}
+
+__attribute__((interrupt(TIMER0_A0_VECTOR)))
+void Timer_A0_ISR(void)
+{
+	sample_ran = false;
+	// A temporary is fine - the queue keeps a copy of the settings
+	if (!SPI.requestTransaction(usci_spi_settings(1000000UL, MSBFIRST, SPI_MODE0), sampleAdc))
+		dropped++;
+	else if (sample_ran)
+		immediate++;
+	else
+		deferred++;
+}
+
+void buttonPress(void)
+{
+	presses++;
+}
+
+int main()
+{
+	const SPISettings display = usci_spi_settings(8000000UL, MSBFIRST, SPI_MODE0);
+	unsigned long last = 0;
+	uint8_t i;
+
+	WDTCTL = WDTPW | WDTHOLD;
+	DCOCTL = CALDCO_16MHZ;
+	BCSCTL1 = CALBC1_16MHZ;
+
+	sysinit(16000000UL);
+	Serial.begin(9600);
+	SPI.begin();
+	pinMode(P2_0, OUTPUT);
+	digitalWrite(P2_0, HIGH);
+	pinMode(P2_1, OUTPUT);
+	digitalWrite(P2_1, HIGH);
+
+	pinMode(4, INPUT_PULLUP);
+	attachInterrupt(4, buttonPress, FALLING);
+	SPI.usingInterrupt(4);
+
+	TA0CCR0 = 50000 - 1;  // 16MHz / 8 / 50000 = 40Hz
+	TA0CCTL0 = CCIE;
+	TA0CTL = TASSEL_2 | ID_3 | MC_1 | TACLR;
+
+	while(1) {
+		SPI.beginTransaction(display);
+		digitalWrite(P2_0, LOW);
+		for (i = 0; i < 16; i++)
+			SPI.transfer(i);
+		delay(10);  // Timer ticks in here get queued
+		digitalWrite(P2_0, HIGH);
+		SPI.endTransaction();  // Runs them
+		delay(5);
+
+		if (millis() - last >= 1000) {
+			last = millis();
+			Serial.print("Sample ");
+			Serial.print(sample);
+			Serial.print(", immediate ");
+			Serial.print(immediate);
+			Serial.print(", deferred ");
+			Serial.print(deferred);
+			Serial.print(", dropped ");
+			Serial.print(dropped);
+			Serial.print(", presses ");
+			Serial.print(presses);
+			Serial.print(", button masked up to ");
+			Serial.print(SPI.maskedMicros(true));
+			Serial.println("us");
+		}
+	}
+	return 0;
+}
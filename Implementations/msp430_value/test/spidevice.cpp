@@ -0,0 +1,68 @@
+#include <AbstractWiring.h>
+#include <SPI_USCI.h>
+#include <SPIDevice.h>
+
+/* Three chips sharing USCI_B0 - a radio with an IRQ line on P2.2, a SPI flash and a display - each with its own
+ * settings and chip select.  Consecutive transactions to the display only load its settings once.
+ */
+
+SPI_USCI<USCI_SPI_B0,UCB0CTL0,UCB0CTL1,UCB0BR0,UCB0BR1,UCB0STAT,UCB0TXBUF,UCB0RXBUF,IFG2,UCB0TXIFG,UCB0RXIFG,IE2,UCB0RXIE,P1DIR,P1OUT,P1SEL,P1SEL2,BIT5,PORT_SELECTION_0_AND_1,P1DIR,P1OUT,P1SEL,P1SEL2,BIT7,PORT_SELECTION_0_AND_1,P1DIR,P1IN,P1SEL,P1SEL2,BIT6,PORT_SELECTION_0_AND_1> SPI;
+
+SPIDevice radio(SPI, P2_0, usci_spi_settings(4000000UL, MSBFIRST, SPI_MODE0), P2_2);
+SPIDevice flash(SPI, P2_1, usci_spi_settings(8000000UL, MSBFIRST, SPI_MODE0));
+SPIDevice display(SPI, P2_3, usci_spi_settings(8000000UL, MSBFIRST, SPI_MODE3));
+
+volatile boolean radio_irq = false;
+
+void radioCallback(void)
+{
+	radio_irq = true;
+}
+
+int main()
+{
+	uint8_t id[3];
+	uint8_t line[16];
+	unsigned int i;
+
+	WDTCTL = WDTPW | WDTHOLD;
+	DCOCTL = CALDCO_16MHZ;
+	BCSCTL1 = CALBC1_16MHZ;
+
+	sysinit(16000000UL);
+	SPI.begin();
+	radio.begin();
+	flash.begin();
+	display.begin();
+
+	pinMode(P2_2, INPUT_PULLUP);
+	attachInterrupt(P2_2, radioCallback, FALLING);
+
+	for (i = 0; i < sizeof(line); i++)
+		line[i] = i;
+
+	while(1) {
+		if (flash.select()) {
+			flash.transfer(0x9F);  // JEDEC ID
+			flash.transfer(NULL, id, sizeof(id));
+			flash.deselect();
+		}
+
+		for (i = 0; i < 8; i++) {
+			if (display.select()) {
+				display.transfer(0x2C);
+				display.write(line, sizeof(line));
+				display.deselect();
+			}
+		}
+
+		if (radio_irq && radio.select()) {
+			radio_irq = false;
+			radio.transfer(0x80);  // Read status
+			radio.transfer(0x00);
+			radio.deselect();
+		}
+		delay(150);
+	}
+	return 0;
+}
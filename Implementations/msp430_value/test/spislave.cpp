@@ -0,0 +1,70 @@
+#include <AbstractWiring.h>
+#include <UART_USCI.h>
+#include <SPI_USCI_Slave.h>
+
+/* Co-processor behind a host SPI master on USCI_B0 (STE = P1.4, SCLK = P1.5, SOMI = P1.6, SIMO = P1.7).
+ *
+ * Every transaction starts with a 4-byte status block {0xA5, sequence, bytes received, underruns}, describing
+ * the previous transaction; after it the host gets back the bytes it sent in that transaction, then 0x00
+ * fill.  The status block is refreshed from the deselect callback, which runs before the slave preloads the
+ * next transaction's first bytes.  Counters are reported on Serial (USCI_A0) once a second.
+ */
+
+UART_USCI <0, UCA0CTL0, UCA0CTL1, UCA0MCTL, UCA0ABCTL, UCA0BR0, UCA0BR1, UCA0STAT, UCA0TXBUF, UCA0RXBUF, IE2, UCA0TXIE, UCA0RXIE, 32, 16, P1SEL, P1SEL2, PORT_SELECTION_0_AND_1, BIT1|BIT2> Serial;
+SPI_USCI_Slave<USCI_SPI_B0,UCB0CTL0,UCB0CTL1,UCB0STAT,UCB0TXBUF,UCB0RXBUF,IFG2,UCB0TXIFG,UCB0RXIFG,IE2,UCB0RXIE,32,32,P1SEL,P1SEL2,BIT5,PORT_SELECTION_0_AND_1,P1SEL,P1SEL2,BIT7,PORT_SELECTION_0_AND_1,P1SEL,P1SEL2,BIT6,PORT_SELECTION_0_AND_1,P1SEL,P1SEL2,BIT4,PORT_SELECTION_0_AND_1> Slave;
+USCI_SPI_SLAVE_ISR_BIND(b0, Slave)
+USCI_ISR_BIND_VECTORS()
+
+uint8_t status[4] = { 0xA5, 0, 0, 0 };
+volatile boolean deselected = false;
+
+void csCallback(boolean selected)
+{
+	if (!selected) {
+		status[1]++;
+		status[2] = (uint8_t)Slave.available();
+		status[3] = (uint8_t)Slave.txUnderruns();
+		deselected = true;
+	}
+}
+
+int main()
+{
+	uint8_t frame[32];
+	size_t n;
+	uint32_t last = 0;
+
+	WDTCTL = WDTPW | WDTHOLD;
+	DCOCTL = CALDCO_16MHZ;
+	BCSCTL1 = CALBC1_16MHZ;
+
+	sysinit(16000000UL);
+	Serial.begin(115200);
+
+	Slave.setFill(0x00);
+	Slave.setResponse(status, sizeof(status));
+	Slave.onSelect(csCallback);
+	Slave.begin(MSBFIRST, SPI_MODE0, P1_4);
+
+	while(1) {
+		if (deselected) {
+			deselected = false;
+			n = 0;
+			while (Slave.available() && n < sizeof(frame))
+				frame[n++] = Slave.read();
+			Slave.write(frame, n);  // Echoed after the status block of the next transaction
+		}
+
+		if (millis() - last >= 1000) {
+			last = millis();
+			Serial.print("rx dropped ");
+			Serial.print(Slave.rxDropped());
+			Serial.print(", overruns ");
+			Serial.print(Slave.overruns());
+			Serial.print(", underruns ");
+			Serial.println(Slave.txUnderruns());
+		}
+		LPM0;  // The chip select ISR wakes us
+	}
+	return 0;
+}
@@ -0,0 +1,71 @@
+#include <AbstractWiring.h>
+#include <UART_USCI.h>
+#include <SPI_USCI_Slave.h>
+
+/* SPI_USCI_Slave per-byte cost, and the SCLK it can keep up with.  USCIAB0 RX vector entry-to-exit time
+ * in MCLK cycles counted by Timer_A, measured the way isrbench does it: UCB0RXIFG (and UCB0TXIFG, as the
+ * USCI would have it once TXBUF moved into the shift register) is raised in software with GIE off, opening
+ * GIE lets exactly one ISR run, and the same sequence without the flags set is subtracted out.
+ *
+ * Each byte is taken from the TX ring - the slowest path - and read() back out of the RX ring between runs.
+ * The ISR has one byte time (8 SCLK periods) before TXBUF underruns, so the highest usable SCLK is
+ * 8 * MCLK / cycles, less whatever other interrupts take.  The slave is statically bound, as it should be.
+ */
+
+#define BENCH_RUNS 64
+
+UART_USCI <0, UCA0CTL0, UCA0CTL1, UCA0MCTL, UCA0ABCTL, UCA0BR0, UCA0BR1, UCA0STAT, UCA0TXBUF, UCA0RXBUF, IE2, UCA0TXIE, UCA0RXIE, 32, 16, P1SEL, P1SEL2, PORT_SELECTION_0_AND_1, BIT1|BIT2> Serial;
+SPI_USCI_Slave<USCI_SPI_B0,UCB0CTL0,UCB0CTL1,UCB0STAT,UCB0TXBUF,UCB0RXBUF,IFG2,UCB0TXIFG,UCB0RXIFG,IE2,UCB0RXIE,32,32,P1SEL,P1SEL2,BIT5,PORT_SELECTION_0_AND_1,P1SEL,P1SEL2,BIT7,PORT_SELECTION_0_AND_1,P1SEL,P1SEL2,BIT6,PORT_SELECTION_0_AND_1,P1SEL,P1SEL2,BIT4,PORT_SELECTION_NONE> Slave;
+USCI_SPI_SLAVE_ISR_BIND(b0, Slave)
+USCI_ISR_BIND_VECTORS()
+
+NEVER_INLINE
+uint16_t time_rx_isr(boolean raise)
+{
+	uint16_t start = TA0R;
+	if (raise)
+		IFG2 |= UCB0RXIFG | UCB0TXIFG;
+	__bis_SR_register(GIE);
+	__bic_SR_register(GIE);
+	return TA0R - start;
+}
+
+int main()
+{
+	unsigned int i;
+	uint32_t t_isr, t_base, cycles;
+
+	WDTCTL = WDTPW | WDTHOLD;
+	DCOCTL = CALDCO_16MHZ;
+	BCSCTL1 = CALBC1_16MHZ;
+
+	sysinit(16000000UL);
+	Serial.begin(115200);
+	Slave.begin(MSBFIRST, SPI_MODE0);
+
+	TA0CTL = TASSEL_2 | MC_2 | TACLR;  // SMCLK, continuous mode
+
+	while(1) {
+		t_isr = 0;
+		t_base = 0;
+		__bic_SR_register(GIE);
+		IE1 &= ~WDTIE;  // Keep the WDT tick out of the measurement
+		for (i = 0; i < BENCH_RUNS; i++) {
+			Slave.write((uint8_t)i);
+			t_base += time_rx_isr(false);
+			t_isr += time_rx_isr(true);
+			Slave.read();
+		}
+		IE1 |= WDTIE;
+		__bis_SR_register(GIE);
+
+		cycles = (t_isr - t_base) / BENCH_RUNS;
+		Serial.print("slave RX ISR: ");
+		Serial.print(cycles);
+		Serial.print(" cycles/byte, max SCLK ~");
+		Serial.print(8UL * F_CPU / cycles);
+		Serial.println(" Hz");
+		delay(1000);
+	}
+	return 0;
+}
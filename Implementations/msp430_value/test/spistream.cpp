@@ -0,0 +1,85 @@
+#include <AbstractWiring.h>
+#include <SPI_USCI.h>
+
+/* A 16-bit SPI DAC on USCI_B0 fed at 8kHz: Timer_A0 paces one 2-byte frame per tick and the stream refills
+ * each half of the sample buffer while the other one is being clocked out.  The DAC latches on LDAC, so CS
+ * stays low for the whole stream.
+ */
+
+SPI_USCI<USCI_SPI_B0,UCB0CTL0,UCB0CTL1,UCB0BR0,UCB0BR1,UCB0STAT,UCB0TXBUF,UCB0RXBUF,IFG2,UCB0TXIFG,UCB0RXIFG,IE2,UCB0RXIE,P1DIR,P1OUT,P1SEL,P1SEL2,BIT5,PORT_SELECTION_0_AND_1,P1DIR,P1OUT,P1SEL,P1SEL2,BIT7,PORT_SELECTION_0_AND_1,P1DIR,P1IN,P1SEL,P1SEL2,BIT6,PORT_SELECTION_0_AND_1> SPI;
+
+#define SAMPLES_PER_HALF 32
+
+uint8_t samples[2 * SAMPLES_PER_HALF * 2];
+volatile uint8_t refill = 0;  // Bit per half waiting to be refilled
+
+__attribute__((interrupt(TIMER0_A0_VECTOR)))
+void Timer_A0_ISR(void)
+{
+	SPI.streamTick();
+}
+
+boolean halfDone(void *arg, uint8_t half)
+{
+	refill |= 1 << half;
+	return false;  // Hold the half until it's refilled
+}
+
+void fill(uint8_t half, uint16_t & phase)
+{
+	uint8_t *p = samples + half * SAMPLES_PER_HALF * 2;
+	unsigned int i;
+
+	for (i = 0; i < SAMPLES_PER_HALF; i++) {
+		uint16_t code = 0x3000 | (phase & 0x0FFF);  // Sawtooth, channel A, 1x gain
+		*p++ = code >> 8;
+		*p++ = code & 0xFF;
+		phase += 64;
+	}
+}
+
+int main()
+{
+	uint16_t phase = 0;
+	uint8_t half;
+
+	WDTCTL = WDTPW | WDTHOLD;
+	DCOCTL = CALDCO_16MHZ;
+	BCSCTL1 = CALBC1_16MHZ;
+
+	sysinit(16000000UL);
+	SPI.begin();
+	SPI.beginTransaction(usci_spi_settings(8000000UL, MSBFIRST, SPI_MODE0));
+	pinMode(P2_0, OUTPUT);
+	digitalWrite(P2_0, LOW);  // DAC CS
+
+	fill(0, phase);
+	fill(1, phase);
+	SPI.beginStream(samples, NULL, SAMPLES_PER_HALF * 2, halfDone, NULL, 2);
+
+	TA0CCR0 = 16000000UL / 8000 - 1;
+	TA0CCTL0 = CCIE;
+	TA0CTL = TASSEL_2 | MC_1 | TACLR;
+
+	while(1) {
+		for (half = 0; half < 2; half++) {
+			if (refill & (1 << half)) {
+				fill(half, phase);
+				__bic_SR_register(GIE);
+				refill &= ~(1 << half);
+				__bis_SR_register(GIE);
+				SPI.streamRelease(half);
+			}
+		}
+		if (SPI.streamUnderruns() || SPI.streamOverruns())
+			break;
+	}
+
+	TA0CTL = 0;
+	SPI.endStream();
+	digitalWrite(P2_0, HIGH);
+	SPI.endTransaction();
+	while(1)
+		delay(1000);
+	return 0;
+}
@@ -5,7 +5,7 @@ void myCallback(void);
 
 volatile boolean is_locked = false;
 
-SPI_USCI<UCB0CTL0,UCB0CTL1,UCB0BR0,UCB0BR1,UCB0STAT,UCB0TXBUF,UCB0RXBUF,P1DIR,P1OUT,P1SEL,P1SEL2,BIT5,PORT_SELECTION_0_AND_1,P1DIR,P1OUT,P1SEL,P1SEL2,BIT7,PORT_SELECTION_0_AND_1,P1DIR,P1IN,P1SEL,P1SEL2,BIT6,PORT_SELECTION_0_AND_1> SPI;
+SPI_USCI<USCI_SPI_B0,UCB0CTL0,UCB0CTL1,UCB0BR0,UCB0BR1,UCB0STAT,UCB0TXBUF,UCB0RXBUF,IFG2,UCB0TXIFG,UCB0RXIFG,IE2,UCB0RXIE,P1DIR,P1OUT,P1SEL,P1SEL2,BIT5,PORT_SELECTION_0_AND_1,P1DIR,P1OUT,P1SEL,P1SEL2,BIT7,PORT_SELECTION_0_AND_1,P1DIR,P1IN,P1SEL,P1SEL2,BIT6,PORT_SELECTION_0_AND_1> SPI;
 
 int main()
 {
@@ -24,7 +24,7 @@ int main()
 	digitalWrite(1, LOW);
 
 	SPISettings a(8000000UL, MSBFIRST, SPI_MODE0);
-	SPISettings b(4000000UL, MSBFIRST, SPI_MODE1);
+	const SPISettings b = usci_spi_settings(4000000UL, MSBFIRST, SPI_MODE1);  // Register image computed at compile time
 
 	while(1) {
 		SPI.beginTransaction(a);
@@ -0,0 +1,80 @@
+#include <AbstractWiring.h>
+#include <UART_USCI.h>
+
+/* UART_USCI_Divisor regression table - checked entirely at compile time, so building this file is the test.
+ *
+ * For each BRCLK/baud pair the search must do at least as well as the setting SLAU144 recommends
+ * (rated with the same error model), and the pairs usable in practice must stay within 2% of a bit.
+ */
+
+#define CHECK_BAUD(brclk, baud, ti_br, ti_brs, ti_brf, ti_os16) \
+	static_assert(usci_uart_best_divisor(brclk, baud).error_ppm <= usci_uart_error_ppm(brclk, baud, ti_br, ti_brs, ti_brf, ti_os16), \
+		"divisor search is worse than SLAU144 at " #brclk "/" #baud)
+#define CHECK_BAUD_LIMIT(brclk, baud) \
+	static_assert(usci_uart_best_divisor(brclk, baud).error_ppm <= USCI_UART_DEFAULT_MAX_ERROR_PPM, \
+		"divisor search exceeds the default error limit at " #brclk "/" #baud)
+
+// UCOS16 = 0
+CHECK_BAUD(1000000UL, 9600, 104, 1, 0, false);
+CHECK_BAUD(1000000UL, 19200, 52, 0, 0, false);
+CHECK_BAUD(1000000UL, 38400, 26, 0, 0, false);
+CHECK_BAUD(1000000UL, 57600, 17, 3, 0, false);
+CHECK_BAUD(1000000UL, 115200, 8, 6, 0, false);
+CHECK_BAUD(8000000UL, 9600, 833, 2, 0, false);
+CHECK_BAUD(8000000UL, 19200, 416, 6, 0, false);
+CHECK_BAUD(8000000UL, 38400, 208, 3, 0, false);
+CHECK_BAUD(8000000UL, 57600, 138, 7, 0, false);
+CHECK_BAUD(8000000UL, 115200, 69, 4, 0, false);
+CHECK_BAUD(8000000UL, 230400, 34, 6, 0, false);
+CHECK_BAUD(8000000UL, 460800, 17, 3, 0, false);
+CHECK_BAUD(16000000UL, 9600, 1666, 6, 0, false);
+CHECK_BAUD(16000000UL, 19200, 833, 2, 0, false);
+CHECK_BAUD(16000000UL, 38400, 416, 6, 0, false);
+CHECK_BAUD(16000000UL, 57600, 277, 7, 0, false);
+CHECK_BAUD(16000000UL, 115200, 138, 7, 0, false);
+CHECK_BAUD(16000000UL, 230400, 69, 4, 0, false);
+CHECK_BAUD(16000000UL, 460800, 34, 6, 0, false);
+CHECK_BAUD(16000000UL, 921600, 17, 3, 0, false);
+
+// UCOS16 = 1
+CHECK_BAUD(1000000UL, 9600, 6, 0, 8, true);
+CHECK_BAUD(8000000UL, 9600, 52, 0, 1, true);
+CHECK_BAUD(8000000UL, 115200, 4, 5, 3, true);
+CHECK_BAUD(16000000UL, 9600, 104, 0, 3, true);
+CHECK_BAUD(16000000UL, 19200, 52, 0, 1, true);
+CHECK_BAUD(16000000UL, 38400, 26, 0, 1, true);
+CHECK_BAUD(16000000UL, 57600, 17, 0, 6, true);
+CHECK_BAUD(16000000UL, 115200, 8, 0, 11, true);
+CHECK_BAUD(16000000UL, 230400, 4, 5, 3, true);
+
+CHECK_BAUD_LIMIT(1000000UL, 9600);
+CHECK_BAUD_LIMIT(1000000UL, 19200);
+CHECK_BAUD_LIMIT(8000000UL, 9600);
+CHECK_BAUD_LIMIT(8000000UL, 57600);
+CHECK_BAUD_LIMIT(8000000UL, 115200);
+CHECK_BAUD_LIMIT(8000000UL, 1000000UL);
+CHECK_BAUD_LIMIT(16000000UL, 9600);
+CHECK_BAUD_LIMIT(16000000UL, 57600);
+CHECK_BAUD_LIMIT(16000000UL, 115200);
+CHECK_BAUD_LIMIT(16000000UL, 230400);
+CHECK_BAUD_LIMIT(16000000UL, 1000000UL);
+
+UART_USCI <0, UCA0CTL0, UCA0CTL1, UCA0MCTL, UCA0ABCTL, UCA0BR0, UCA0BR1, UCA0STAT, UCA0TXBUF, UCA0RXBUF, IE2, UCA0TXIE, UCA0RXIE, 32, 16, P1SEL, P1SEL2, PORT_SELECTION_0_AND_1, BIT1|BIT2> Serial;
+
+int main()
+{
+	WDTCTL = WDTPW | WDTHOLD;
+	DCOCTL = CALDCO_16MHZ;
+	BCSCTL1 = CALBC1_16MHZ;
+
+	sysinit(16000000UL);
+	Serial.begin<1000000UL>();
+
+	while(1) {
+		Serial.print("1Mbaud divisor error: ");
+		Serial.print((unsigned long)USCI_UART_Divisor<F_CPU, 1000000UL>::error_ppm);
+		Serial.println(" ppm");
+		delay(1000);
+	}
+	return 0;
+}
@@ -0,0 +1,70 @@
+#include <AbstractWiring.h>
+#include <UART_USCI.h>
+#include <Wire_USCI.h>
+
+/* Six 2-byte sensor registers polled every 10ms through the asynchronous queue.  Each poll is a
+ * write-then-read descriptor; the whole round runs from the USCI ISRs while the main loop keeps counting.
+ */
+
+UART_USCI <0, UCA0CTL0, UCA0CTL1, UCA0MCTL, UCA0ABCTL, UCA0BR0, UCA0BR1, UCA0STAT, UCA0TXBUF, UCA0RXBUF, IE2, UCA0TXIE, UCA0RXIE, 16, 2, P1SEL, P1SEL2, PORT_SELECTION_0_AND_1, BIT1|BIT2> Serial;
+Wire_USCI<0, UCB0CTL0, UCB0CTL1, UCB0BR0, UCB0BR1, UCB0STAT, UCB0I2COA, UCB0I2CSA, UCB0TXBUF, UCB0RXBUF, UCB0I2CIE, UCB0STAT, IE2, IFG2, UCB0TXIE, UCB0RXIE, UCB0TXIFG, UCB0RXIFG, P1SEL, P1SEL2, PORT_SELECTION_0_AND_1, BIT6|BIT7, 4, 4> Wire;
+USCI_TWOWIRE_ISR_BIND(0, Wire)
+USCI_ISR_BIND_VECTORS()
+
+#define SENSORS 6
+
+const uint8_t sensor_reg = 0x00;
+uint8_t readings[SENSORS][2];
+struct twowire_transaction polls[SENSORS];
+volatile uint8_t done = 0;
+
+void pollDone(struct twowire_transaction *t)
+{
+	done++;
+}
+
+int main()
+{
+	unsigned long last = 0, spins = 0;
+	unsigned int i;
+
+	WDTCTL = WDTPW | WDTHOLD;
+	DCOCTL = CALDCO_16MHZ;
+	BCSCTL1 = CALBC1_16MHZ;
+
+	sysinit(16000000UL);
+	Wire.setSpeed(400000UL);
+	Wire.begin();
+	Serial.begin(9600);
+
+	for (i = 0; i < SENSORS; i++) {
+		polls[i].addr = 0x48 + i;
+		polls[i].tx = &sensor_reg;
+		polls[i].txlen = 1;
+		polls[i].rx = readings[i];
+		polls[i].rxlen = 2;
+		polls[i].timeout_ms = 2;  // A missing or wedged sensor mustn't hold up the other five
+		polls[i].callback = pollDone;
+		polls[i].arg = NULL;
+	}
+
+	while(1) {
+		Wire.checkTimeout();
+		if (millis() - last >= 10 && !Wire.isBusy()) {
+			last = millis();
+			if (done == SENSORS) {
+				for (i = 0; i < SENSORS; i++) {
+					Serial.print(polls[i].status == TWOWIRE_OK ? (int)word(readings[i][0], readings[i][1]) : -1);
+					Serial.print(' ');
+				}
+				Serial.println(spins);
+			}
+			done = 0;
+			spins = 0;
+			for (i = 0; i < SENSORS; i++)
+				Wire.queueTransaction(&polls[i]);
+		}
+		spins++;  // The "other work" - free CPU while the sensors are being read
+	}
+	return 0;
+}
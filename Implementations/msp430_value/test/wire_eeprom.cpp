@@ -0,0 +1,58 @@
+#include <AbstractWiring.h>
+#include <UART_USCI.h>
+#include <Wire_USCI.h>
+
+/* 24LC256 EEPROM (0x50) page write and read-back.  The page goes into txbuf with a single bulk write() and
+ * comes back through requestFrom(addr, dst, len) straight into the application's buffer, so rxbuf_len can
+ * stay at 2 even though the page is 32 bytes.
+ */
+
+UART_USCI <0, UCA0CTL0, UCA0CTL1, UCA0MCTL, UCA0ABCTL, UCA0BR0, UCA0BR1, UCA0STAT, UCA0TXBUF, UCA0RXBUF, IE2, UCA0TXIE, UCA0RXIE, 16, 2, P1SEL, P1SEL2, PORT_SELECTION_0_AND_1, BIT1|BIT2> Serial;
+Wire_USCI<0, UCB0CTL0, UCB0CTL1, UCB0BR0, UCB0BR1, UCB0STAT, UCB0I2COA, UCB0I2CSA, UCB0TXBUF, UCB0RXBUF, UCB0I2CIE, UCB0STAT, IE2, IFG2, UCB0TXIE, UCB0RXIE, UCB0TXIFG, UCB0RXIFG, P1SEL, P1SEL2, PORT_SELECTION_0_AND_1, BIT6|BIT7, 34, 2> Wire;
+
+#define EEPROM_ADDR 0x50
+#define PAGE_SIZE 32
+
+int main()
+{
+	uint8_t page[PAGE_SIZE], readback[PAGE_SIZE];
+	uint16_t mem = 0x0000;
+	unsigned int i;
+
+	WDTCTL = WDTPW | WDTHOLD;
+	DCOCTL = CALDCO_16MHZ;
+	BCSCTL1 = CALBC1_16MHZ;
+
+	sysinit(16000000UL);
+	Wire.setSpeed(400000UL);
+	Wire.begin();
+	Serial.begin(9600);
+
+	while(1) {
+		for (i = 0; i < PAGE_SIZE; i++)
+			page[i] = (uint8_t)(mem + i);
+
+		Wire.beginTransmission(EEPROM_ADDR);
+		Wire.write(mem >> 8);
+		Wire.write(mem & 0xFF);
+		Wire.write(page, sizeof(page));
+		if (!Wire.endTransmission()) {
+			Serial.println("Page write failed");
+		} else {
+			delay(5);  // Write cycle
+
+			Wire.beginTransmission(EEPROM_ADDR);
+			Wire.write(mem >> 8);
+			Wire.write(mem & 0xFF);
+			if (Wire.endTransmission(false) && Wire.requestFrom(EEPROM_ADDR, readback, sizeof(readback)) == sizeof(readback))
+				Serial.println(memcmp(page, readback, PAGE_SIZE) ? "Readback mismatch" : "Page OK");
+			else
+				Serial.println("Page read failed");
+		}
+		Serial.flush();
+
+		mem += PAGE_SIZE;
+		delay(1000);
+	}
+	return 0;
+}
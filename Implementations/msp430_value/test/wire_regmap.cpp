@@ -0,0 +1,52 @@
+#include <AbstractWiring.h>
+#include <Wire_USCI.h>
+#include <usci_isr.h>
+
+/* I2C port expander slave at 0x20 served entirely from the USCI ISRs by setRegisterMap():
+ *   0 - P2IN  (read only)
+ *   1 - P2OUT (read/write)
+ *   2 - P2DIR (read/write)
+ *   3 - ID    (read only)
+ * The master writes the register number followed by data, or writes the register number and reads back
+ * with a repeated START; the pointer auto-increments.  The main loop wakes on each STOP, applies the
+ * registers the master wrote and refreshes P2IN.
+ */
+
+Wire_USCI<0, UCB0CTL0, UCB0CTL1, UCB0BR0, UCB0BR1, UCB0STAT, UCB0I2COA, UCB0I2CSA, UCB0TXBUF, UCB0RXBUF, UCB0I2CIE, UCB0STAT, IE2, IFG2, UCB0TXIE, UCB0RXIE, UCB0TXIFG, UCB0RXIFG, P1SEL, P1SEL2, PORT_SELECTION_0_AND_1, BIT6|BIT7, 2, 2> Wire;
+USCI_TWOWIRE_ISR_BIND(0, Wire)
+USCI_ISR_BIND_VECTORS()
+
+#define SLAVE_ADDR 0x20
+
+enum { REG_IN, REG_OUT, REG_DIR, REG_ID, REG_COUNT };
+
+volatile uint8_t regs[REG_COUNT] = { 0x00, 0x00, 0x00, 0xA5 };
+const uint8_t writable[REG_COUNT] = { 0x00, 0xFF, 0xFF, 0x00 };
+volatile uint8_t dirty[(REG_COUNT + 7) / 8];
+
+int main()
+{
+	WDTCTL = WDTPW | WDTHOLD;
+	DCOCTL = CALDCO_16MHZ;
+	BCSCTL1 = CALBC1_16MHZ;
+
+	sysinit(16000000UL);
+	P2SEL = 0x00;
+	P2SEL2 = 0x00;
+	P2DIR = regs[REG_DIR];
+	P2OUT = regs[REG_OUT];
+
+	Wire.setRegisterMap(regs, REG_COUNT, writable, dirty);
+	Wire.begin(SLAVE_ADDR);
+
+	while(1) {
+		if (Wire.registerDirty(REG_OUT))
+			P2OUT = regs[REG_OUT];
+		if (Wire.registerDirty(REG_DIR))
+			P2DIR = regs[REG_DIR];
+		regs[REG_IN] = P2IN;
+
+		LPM0;  // A STOP wakes us
+	}
+	return 0;
+}
@@ -0,0 +1,51 @@
+#include <AbstractWiring.h>
+#include <UART_USCI.h>
+#include <Wire_USCI.h>
+
+/* Polls a TMP102 (0x48) temperature register at 400kHz - once with writeThenRead() into a local buffer, once
+ * the Arduino way with endTransmission(false) and requestFrom().  Both use a repeated START between the
+ * register pointer write and the read.
+ */
+
+UART_USCI <0, UCA0CTL0, UCA0CTL1, UCA0MCTL, UCA0ABCTL, UCA0BR0, UCA0BR1, UCA0STAT, UCA0TXBUF, UCA0RXBUF, IE2, UCA0TXIE, UCA0RXIE, 16, 2, P1SEL, P1SEL2, PORT_SELECTION_0_AND_1, BIT1|BIT2> Serial;
+Wire_USCI<0, UCB0CTL0, UCB0CTL1, UCB0BR0, UCB0BR1, UCB0STAT, UCB0I2COA, UCB0I2CSA, UCB0TXBUF, UCB0RXBUF, UCB0I2CIE, UCB0STAT, IE2, IFG2, UCB0TXIE, UCB0RXIE, UCB0TXIFG, UCB0RXIFG, P1SEL, P1SEL2, PORT_SELECTION_0_AND_1, BIT6|BIT7, 4, 4> Wire;
+
+#define TMP102_ADDR 0x48
+
+int main()
+{
+	const uint8_t reg = 0x00;  // Temperature register
+	uint8_t temp[2];
+
+	WDTCTL = WDTPW | WDTHOLD;
+	DCOCTL = CALDCO_16MHZ;
+	BCSCTL1 = CALBC1_16MHZ;
+
+	sysinit(16000000UL);
+	Wire.setSpeed(400000UL);
+	Wire.begin();
+	Serial.begin(9600);
+
+	while(1) {
+		if (Wire.writeThenRead(TMP102_ADDR, &reg, 1, temp, sizeof(temp))) {
+			Serial.print("writeThenRead: ");
+			Serial.println((int16_t)word(temp[0], temp[1]) >> 4);
+		} else {
+			Serial.println("writeThenRead failed");
+		}
+
+		Wire.beginTransmission(TMP102_ADDR);
+		Wire.write(reg);
+		if (Wire.endTransmission(false) && Wire.requestFrom(TMP102_ADDR, 2) == 2) {
+			temp[0] = Wire.read();
+			temp[1] = Wire.read();
+			Serial.print("requestFrom: ");
+			Serial.println((int16_t)word(temp[0], temp[1]) >> 4);
+		} else {
+			Serial.println("requestFrom failed");
+		}
+		Serial.flush();
+		delay(1000);
+	}
+	return 0;
+}
@@ -0,0 +1,47 @@
+#include <AbstractWiring.h>
+#include <UART_USCI.h>
+#include <Wire_USCI.h>
+
+/* I2C bus scan - an empty beginTransmission()/endTransmission() pair probes each 7-bit address.  A missing
+ * device NACKs its address and the probe fails right away; setAddressTimeout() only bounds a wedged bus.
+ */
+
+UART_USCI <0, UCA0CTL0, UCA0CTL1, UCA0MCTL, UCA0ABCTL, UCA0BR0, UCA0BR1, UCA0STAT, UCA0TXBUF, UCA0RXBUF, IE2, UCA0TXIE, UCA0RXIE, 16, 2, P1SEL, P1SEL2, PORT_SELECTION_0_AND_1, BIT1|BIT2> Serial;
+Wire_USCI<0, UCB0CTL0, UCB0CTL1, UCB0BR0, UCB0BR1, UCB0STAT, UCB0I2COA, UCB0I2CSA, UCB0TXBUF, UCB0RXBUF, UCB0I2CIE, UCB0STAT, IE2, IFG2, UCB0TXIE, UCB0RXIE, UCB0TXIFG, UCB0RXIFG, P1SEL, P1SEL2, PORT_SELECTION_0_AND_1, BIT6|BIT7, 4, 4> Wire;
+
+int main()
+{
+	unsigned long start, elapsed;
+	uint8_t addr, found;
+
+	WDTCTL = WDTPW | WDTHOLD;
+	DCOCTL = CALDCO_16MHZ;
+	BCSCTL1 = CALBC1_16MHZ;
+
+	sysinit(16000000UL);
+	Wire.setSpeed(400000UL);
+	Wire.setAddressTimeout(2);
+	Wire.begin();
+	Serial.begin(9600);
+
+	while(1) {
+		found = 0;
+		start = micros();
+		for (addr = 0x08; addr < 0x78; addr++) {
+			Wire.beginTransmission(addr);
+			if (Wire.endTransmission()) {
+				Serial.print("Found 0x");
+				Serial.println(addr, HEX);
+				found++;
+			}
+		}
+		elapsed = micros() - start;
+		Serial.print(found);
+		Serial.print(" devices, scan took ");
+		Serial.print(elapsed);
+		Serial.println("us");
+		Serial.flush();
+		delay(5000);
+	}
+	return 0;
+}
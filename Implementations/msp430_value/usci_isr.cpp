@@ -3,77 +3,30 @@
 #include <AbstractWiring.h>
 #include <UART_USCI_EXTISR.h>
 #include <TwoWire_USCI_EXTISR.h>
+#include <SPI_USCI_EXTISR.h>
+#include <usci_isr.h>
 
 
 UART_USCI_EXTISR *isr_usci_uart_instance[1] = { NULL };
 TwoWire_USCI_EXTISR *isr_usci_twowire_instance[1] = { NULL };
+SPI_USCI_EXTISR *isr_usci_spi_instance[2] = { NULL, NULL };
+SPI_USCI_Slave_EXTISR *isr_usci_spi_slave_instance[2] = { NULL, NULL };
 
 extern "C" {
 
 void usci_isr_installer(void) { ; }
 
-__attribute__((interrupt(USCIAB0TX_VECTOR)))
+// Default vectors, with every hook dispatching through the vtables; weak so USCI_ISR_BIND_VECTORS() can replace them
+__attribute__((interrupt(USCIAB0TX_VECTOR), weak))
 void USCIAB0_TX(void)
 {
-    boolean still_asleep = _sys_asleep;
-
-    if (IFG2 & UCA0TXIFG) {
-        if (UCA0CTL0 & UCSYNC) {
-            // SPI Slave Mode
-            // TODO
-        } else {
-            // UART
-            isr_usci_uart_instance[0]->isr_send_char();
-        }
-    }
-
-    if ( (UCB0CTL0 & UCMODE_3) == UCMODE_3 ) {
-        if (IFG2 & (UCB0TXIFG | UCB0RXIFG)) {
-            // I2C
-            if (isr_usci_twowire_instance[0]->isr_handle_txrx())
-                __bic_SR_register_on_exit(LPM4_bits);
-        }
-    } else {
-        if (IFG2 & UCB0TXIFG) {
-            // SPI Slave
-            // TODO
-        }
-    }
-
-    if (still_asleep != _sys_asleep)
-        __bic_SR_register_on_exit(LPM4_bits);
+    usci_isr_ab_tx<0>();
 }
 
-__attribute__((interrupt(USCIAB0RX_VECTOR)))
+__attribute__((interrupt(USCIAB0RX_VECTOR), weak))
 void USCIAB0_RX(void)
 {
-    boolean still_asleep = _sys_asleep;
-
-    if (IFG2 & UCA0RXIFG) {
-        if (UCA0CTL0 & UCSYNC) {
-            // SPI Slave Mode
-            // TODO
-        } else {
-            // UART
-            isr_usci_uart_instance[0]->isr_get_char();
-        }
-    }
-
-    if ( (UCB0CTL0 & UCMODE_3) == UCMODE_3 ) {
-        if (UCB0STAT & (UCNACKIFG | UCSTPIFG | UCSTTIFG | UCALIFG)) {
-            // I2C
-            if (isr_usci_twowire_instance[0]->isr_handle_control())
-                __bic_SR_register_on_exit(LPM4_bits);
-        }
-    } else {
-        if (IFG2 & UCB0RXIFG) {
-            // SPI Slave Mode
-            // TODO
-        }
-    }
-
-    if (still_asleep != _sys_asleep)
-        __bic_SR_register_on_exit(LPM4_bits);
+    usci_isr_ab_rx<0>();
 }
 
 
@@ -5,6 +5,7 @@
 
 #include <UART_USCI_EXTISR.h>
 #include <TwoWire_USCI_EXTISR.h>
+#include <SPI_USCI_EXTISR.h>
 
 #ifdef __cplusplus
 extern "C" {
@@ -13,9 +14,144 @@ extern "C" {
 void usci_isr_installer();
 extern UART_USCI_EXTISR *isr_usci_uart_instance[];
 extern TwoWire_USCI_EXTISR *isr_usci_twowire_instance[];
+extern SPI_USCI_EXTISR *isr_usci_spi_instance[];  // Indexed by enum USCI_SPI_Instance
+extern SPI_USCI_Slave_EXTISR *isr_usci_spi_slave_instance[];  // Ditto
 
 #ifdef __cplusplus
 };  /* extern "C" */
 #endif
 
+/* Per-instance handler hooks called by the USCI vectors.  The primary templates dispatch through the vtables
+ * above; USCI_*_ISR_BIND() specializes them for a concrete object, so its handlers inline into the vectors.
+ * Internal linkage, as usci_isr.cpp and a binding translation unit see different hooks under the same names.
+ */
+namespace {
+
+template <int inst> struct usci_uart_isr {
+    static inline void tx(void) { isr_usci_uart_instance[inst]->isr_send_char(); }
+    static inline boolean rx(void) { return isr_usci_uart_instance[inst]->isr_get_char(); }
+};
+
+template <int inst> struct usci_twowire_isr {
+    static inline boolean txrx(void) { return isr_usci_twowire_instance[inst]->isr_handle_txrx(); }
+    static inline boolean control(void) { return isr_usci_twowire_instance[inst]->isr_handle_control(); }
+};
+
+// SPI hooks are indexed by enum USCI_SPI_Instance; the bind macros name the module, hence the aliases
+enum { usci_spi_a0 = USCI_SPI_A0, usci_spi_b0 = USCI_SPI_B0 };
+
+template <int inst> struct usci_spi_isr {
+    static inline boolean rx(void) { return isr_usci_spi_instance[inst]->isr_handle_rx(); }
+};
+
+template <int inst> struct usci_spi_slave_isr {
+    static inline boolean rx(void) { return isr_usci_spi_slave_instance[inst]->isr_handle_rx(); }
+};
+
+/* Vector bodies for the USCI pair ab (only USCIAB0 on these parts).  Templates, with every hook depending on
+ * ab, so the hooks are picked where they're instantiated - in usci_isr.cpp for the default vectors, after the
+ * bind macros for USCI_ISR_BIND_VECTORS().
+ */
+template <int ab>
+__attribute__((always_inline))
+inline void usci_isr_ab_tx(void)
+{
+    boolean still_asleep = _sys_asleep;
+
+    // SPI keeps TXIE off on both USCIs - master and slave alike refill TXBUF from the RX vector
+    if ((IFG2 & UCA0TXIFG) && !(UCA0CTL0 & UCSYNC)) {
+        // UART
+        usci_uart_isr<ab>::tx();
+    }
+
+    if ( (UCB0CTL0 & UCMODE_3) == UCMODE_3 ) {
+        if (IFG2 & (UCB0TXIFG | UCB0RXIFG)) {
+            // I2C
+            if (usci_twowire_isr<ab>::txrx())
+                __bic_SR_register_on_exit(LPM4_bits);
+        }
+    }
+
+    if (still_asleep != _sys_asleep)
+        __bic_SR_register_on_exit(LPM4_bits);
+}
+
+template <int ab>
+__attribute__((always_inline))
+inline void usci_isr_ab_rx(void)
+{
+    boolean still_asleep = _sys_asleep;
+
+    if (IFG2 & UCA0RXIFG) {
+        if (UCA0CTL0 & UCSYNC) {
+            // SPI - as master RXIE is only on while an asynchronous transfer runs; blocking transfers poll RXIFG themselves
+            if (IE2 & UCA0RXIE) {
+                if ((UCA0CTL0 & UCMST) ? usci_spi_isr<usci_spi_a0 + 2 * ab>::rx() : usci_spi_slave_isr<usci_spi_a0 + 2 * ab>::rx())
+                    __bic_SR_register_on_exit(LPM4_bits);
+            }
+        } else {
+            // UART
+            if (usci_uart_isr<ab>::rx())
+                __bic_SR_register_on_exit(LPM4_bits);
+        }
+    }
+
+    if ( (UCB0CTL0 & UCMODE_3) == UCMODE_3 ) {
+        if (UCB0STAT & (UCNACKIFG | UCSTPIFG | UCSTTIFG | UCALIFG)) {
+            // I2C
+            if (usci_twowire_isr<ab>::control())
+                __bic_SR_register_on_exit(LPM4_bits);
+        }
+    } else {
+        if ((IFG2 & UCB0RXIFG) && (IE2 & UCB0RXIE)) {
+            // SPI
+            if ((UCB0CTL0 & UCMST) ? usci_spi_isr<usci_spi_b0 + 2 * ab>::rx() : usci_spi_slave_isr<usci_spi_b0 + 2 * ab>::rx())
+                __bic_SR_register_on_exit(LPM4_bits);
+        }
+    }
+
+    if (still_asleep != _sys_asleep)
+        __bic_SR_register_on_exit(LPM4_bits);
+}
+
+}  /* namespace */
+
+/* Static ISR binding - bind each driver object after its definition, then define the vectors once, e.g.
+ *
+ *   UART_USCI<0, UCA0CTL0, ...> Serial;
+ *   Wire_USCI<0, UCB0CTL0, ...> Wire;
+ *   USCI_UART_ISR_BIND(0, Serial)
+ *   USCI_TWOWIRE_ISR_BIND(0, Wire)
+ *   USCI_ISR_BIND_VECTORS()
+ *
+ * The vectors in usci_isr.cpp are weak; these replace them in the application's translation unit, where the
+ * bound handlers inline into the vector itself and the unbound ones keep the vtable call.
+ */
+#define USCI_UART_ISR_BIND(inst, obj) \
+    namespace { template <> struct usci_uart_isr<inst> { \
+        static inline void tx(void) { obj.isr_send_char(); } \
+        static inline boolean rx(void) { return obj.isr_get_char(); } \
+    }; }
+
+#define USCI_TWOWIRE_ISR_BIND(inst, obj) \
+    namespace { template <> struct usci_twowire_isr<inst> { \
+        static inline boolean txrx(void) { return obj.isr_handle_txrx(); } \
+        static inline boolean control(void) { return obj.isr_handle_control(); } \
+    }; }
+
+// SPI takes the module name instead of a number, e.g. USCI_SPI_ISR_BIND(b0, SPI)
+#define USCI_SPI_ISR_BIND(inst, obj) \
+    namespace { template <> struct usci_spi_isr<usci_spi_##inst> { \
+        static inline boolean rx(void) { return obj.isr_handle_rx(); } \
+    }; }
+
+#define USCI_SPI_SLAVE_ISR_BIND(inst, obj) \
+    namespace { template <> struct usci_spi_slave_isr<usci_spi_##inst> { \
+        static inline boolean rx(void) { return obj.isr_handle_rx(); } \
+    }; }
+
+#define USCI_ISR_BIND_VECTORS() \
+    extern "C" __attribute__((__interrupt__)) void USCIAB0_TX(void) { usci_isr_ab_tx<0>(); } \
+    extern "C" __attribute__((__interrupt__)) void USCIAB0_RX(void) { usci_isr_ab_rx<0>(); }
+
 #endif /* USCI_ISR_H */
@@ -9,10 +9,49 @@
 #define RSPI_RX210_H
 
 #include <SPI.h>
+#include <SPIStream.h>
 #include <iodefine.h>
 
+#ifndef F_CPU
 #define F_CPU 50000000UL
+#endif
+#ifndef PCLK_CPU
 #define PCLK_CPU (F_CPU / (1 << ((SYSTEM.SCKCR.LONG & 0x00000F00) >> 8)))
+#endif
+
+/* Register image (see SPISettings::_image) - SPBR in bits 0-7 and the SPCMD0 clock mode/bit order bits in
+ * bits 8-23.  constexpr, so with a constant PCLK the image can be built at compile time:
+ *
+ *   const SPISettings flash = rspi_rx210_settings(25000000UL, 8000000UL, MSBFIRST, SPI_MODE0);
+ */
+
+// Slowest SPBR (with SPCMD.BRDV = 0) whose bit rate, PCLK / (2 * (SPBR+1)), doesn't exceed bitrate
+constexpr uint8_t rspi_rx210_spbr(uint32_t pclk, uint32_t bitrate)
+{
+	return (pclk / (2 * (bitrate + 1)) > 255) ? 255 : (uint8_t)(pclk / (2 * (bitrate + 1)));
+}
+
+constexpr uint16_t rspi_rx210_spcmd(uint8_t bitorder, uint8_t mode)
+{
+	return (bitorder != MSBFIRST ? BITC : 0) |  // RSPI LSB First
+	       ((mode == SPI_MODE1) ? BIT0 :            // CPOL=0, CPHA=1
+	        (mode == SPI_MODE2) ? BIT1 :            // CPOL=1, CPHA=0
+	        (mode == SPI_MODE3) ? (BIT0 | BIT1) :   // CPOL=1, CPHA=1
+	        0);                                     // SPI mode0 = CPOL=0, CPHA=0
+}
+
+// SPCMD.SPB - frame length; BITA = 8, BITB = 9, all four = 16, BIT8|BIT9 = 32 bits
+#define RSPI_SPCMD_FRAMESIZE_BITS (BIT8 | BIT9 | BITA | BITB)
+
+constexpr uint32_t rspi_rx210_image(uint32_t pclk, uint32_t clock, uint8_t bitorder, uint8_t mode)
+{
+	return rspi_rx210_spbr(pclk, clock) | ((uint32_t)rspi_rx210_spcmd(bitorder, mode) << 8);
+}
+
+constexpr SPISettings rspi_rx210_settings(uint32_t pclk, uint32_t clock, uint8_t bitorder, uint8_t mode)
+{
+	return SPISettings(clock, bitorder, mode, rspi_rx210_image(pclk, clock, bitorder, mode));
+}
 
 template <
 	volatile struct st_rspi & rspidrv
@@ -21,66 +60,141 @@ class RSPI_RX210 : public SPIClass {
 	private:
 		SPISettings _settings, _settings_old;
 		boolean _transaction_semaphore;
+		boolean _transaction_released;  // Last transaction ended by releaseTransaction(); hardware still holds _settings
 		int _mask_irq;
+		uint16_t _spcmd;  // Shadow of SPCMD0, so frame size checks don't go out to the peripheral bus
+		uint8_t _spdcr;  // Shadow of SPDCR
+		SPIStream _stream;
+
+		// Image of s, computing and caching it on first use
+		static uint32_t _image_of(const SPISettings & s) {
+			if (s._image == SPI_SETTINGS_NO_IMAGE)
+				s._image = rspi_rx210_image(PCLK_CPU, s._clock, s._bitorder, s._datamode);
+			return s._image;
+		};
+
+		// Images never carry a frame size, so the current one is kept
+		void _load_image(uint32_t image) {
+			rspidrv.SPBR = (uint8_t)image;  // SPBR happens not to be bitfielded.
+			_spcmd = (uint16_t)(image >> 8) | (_spcmd & RSPI_SPCMD_FRAMESIZE_BITS);
+			rspidrv.SPCMD0.WORD = _spcmd;
+		};
+
+		void _frame_size(uint16_t bits) {
+			if ((_spcmd & RSPI_SPCMD_FRAMESIZE_BITS) != bits) {
+				_spcmd = (_spcmd & ~RSPI_SPCMD_FRAMESIZE_BITS) | bits;
+				rspidrv.SPCMD0.WORD = _spcmd;
+			}
+		};
+
+		void _data_control(uint8_t spdcr) {
+			if (_spdcr != spdcr) {
+				_spdcr = spdcr;
+				rspidrv.SPDCR.BYTE = spdcr;
+			}
+		};
+
+		// Byte order within a multi-byte frame follows the bit order, so bytes hit the wire in buffer order
+		static uint32_t _pack(const uint8_t *p, unsigned int bytes, boolean msbfirst) {
+			uint32_t v = 0;
+
+			if (p == NULL)
+				return 0xFFFFFFFFUL;
+			for (unsigned int i = 0; i < bytes; i++) {
+				if (msbfirst)
+					v = (v << 8) | p[i];
+				else
+					v |= (uint32_t)p[i] << (8 * i);
+			}
+			return v;
+		};
+
+		static void _unpack(uint8_t *p, unsigned int bytes, boolean msbfirst, uint32_t v) {
+			for (unsigned int i = 0; i < bytes; i++) {
+				if (msbfirst)
+					p[i] = (uint8_t)(v >> (8 * (bytes - 1 - i)));
+				else
+					p[i] = (uint8_t)(v >> (8 * i));
+			}
+		};
+
+		/* Moves `frames' frames of `bytes' bytes each in bursts of `burst' frames (1-4, must divide `frames').
+		 * SPTEF rises once the last frame of a burst has moved into the shift register, so the next burst is
+		 * queued while that frame is still shifting and SCK doesn't stall between bursts; the burst received
+		 * meanwhile is read back within the following frame time.  The 32-bit frame length needs SPLW=1.
+		 */
+		void _burst(const uint8_t *& tx, uint8_t *& rx, size_t frames, unsigned int bytes, unsigned int burst) {
+			boolean msbfirst = (_settings._bitorder == MSBFIRST);
+			size_t written = 0, read = 0;
+
+			_frame_size((bytes == 4) ? (BIT8 | BIT9) : (bytes == 2) ? RSPI_SPCMD_FRAMESIZE_BITS : BITA);
+			_data_control((uint8_t)(burst - 1) | BIT5);  // SPFC = burst - 1, SPLW = 1
+			while (read < frames) {
+				if (written < frames) {
+					while (!rspidrv.SPSR.BIT.SPTEF)
+						;  // Waiting for the transmit buffer to empty...
+					for (unsigned int i = 0; i < burst; i++) {
+						rspidrv.SPDR.LONG = _pack(tx, bytes, msbfirst);
+						if (tx != NULL)
+							tx += bytes;
+					}
+					written += burst;
+				}
+				if (written - read > burst || written == frames) {
+					while (!rspidrv.SPSR.BIT.SPRF)
+						;  // Waiting for the whole burst to arrive...
+					for (unsigned int i = 0; i < burst; i++) {
+						uint32_t v = rspidrv.SPDR.LONG;
+						if (rx != NULL) {
+							_unpack(rx, bytes, msbfirst, v);
+							rx += bytes;
+						}
+					}
+					read += burst;
+				}
+			}
+		};
 
 	public:
 		__noinline
 		void begin(void) {
 			_mask_irq = 0;
+			_transaction_released = false;
+			_spcmd = 0;
+			_spdcr = 0x00;
 			rspidrv.SPCR.BYTE = BIT0 | BIT3;  // 3-wire SPI, Full-Duplex, no interrupts, Disabled
 			rspidrv.SPPCR.BYTE = BIT5;  // MOSI at rest = 0
 			rspidrv.SPSCR.BYTE = 0x00;  // Repeat SPCMD0 continuously
-			configClock(_settings._clock);
 			rspidrv.SPDCR.BYTE = 0x00;  // Simple 1-frame buffer mode
 			rspidrv.SPCKD.BYTE = 0x00;  // Minimal delay before SCK generation
 			rspidrv.SPCR2.BYTE = 0x00;  // No parity
-			configMode(_settings._bitorder, _settings._datamode);
+			_load_image(_image_of(_settings));  // SPBR, SPCMD0
 			rspidrv.SPCR.BIT.SPE = 1;
 			// Ready to roll!
 		};
 
 		__noinline
-		void begin(SPISettings s) {
+		void begin(const SPISettings & s) {
 			_settings.copy(s);
 			begin();
 		}
 
 		__noinline
 		void configClock(uint32_t bitrate) {
-			uint32_t i, thisbr;
-			for (i = 0; i < 256; i++) {
-				thisbr = PCLK_CPU / (2 * (i+1));
-				if (thisbr <= bitrate) {
-					rspidrv.SPBR = (uint8_t)i;
-					return;
-				}
-			}
-			rspidrv.SPBR = 255;  // SPBR happens not to be bitfielded.
+			rspidrv.SPBR = rspi_rx210_spbr(PCLK_CPU, bitrate);  // SPBR happens not to be bitfielded.
+			_settings._image = SPI_SETTINGS_NO_IMAGE;  // Hardware no longer matches the cached image
 		};
 
 		__noinline
 		void configMode(uint8_t bitorder, uint8_t mode) {
-			uint16_t cmd = 0x0000;
-			if (bitorder != MSBFIRST)
-				cmd |= BITC;  // RSPI LSB First
-			switch (mode) {
-				case SPI_MODE1:
-					cmd |= BIT0;  // CPOL=0, CPHA=1
-					break;
-				case SPI_MODE2:
-					cmd |= BIT1;  // CPOL=1, CPHA=0
-					break;
-				case SPI_MODE3:
-					cmd |= BIT0 | BIT1;  // CPOL=1, CPHA=1
-					break;
-				default: // SPI mode0 = CPOL=0, CPHA=0
-					break;
-			}
-			rspidrv.SPCMD0.WORD = cmd;
+			_spcmd = rspi_rx210_spcmd(bitorder, mode) | (_spcmd & RSPI_SPCMD_FRAMESIZE_BITS);
+			rspidrv.SPCMD0.WORD = _spcmd;
+			_settings._image = SPI_SETTINGS_NO_IMAGE;
 		};
 
 		__noinline
 		void end(void) {
+			_stream.stop();
 			rspidrv.SPCR.BYTE = 0x00;  // Disable
 		};
 
@@ -107,31 +221,22 @@ class RSPI_RX210 : public SPIClass {
 		};
 
 		// Data transfer
-		#define RSPI_SPCMD_FRAMESIZE_BITS (BIT8 | BIT9 | BITA | BITB)
 		__noinline
 		uint8_t transfer(uint8_t inb) {
-			uint16_t cmd = rspidrv.SPCMD0.WORD;
-			if ( (cmd & RSPI_SPCMD_FRAMESIZE_BITS) != BITA ) {
-				// SPI currently not set to 8-bit mode; change this
-				cmd &= ~RSPI_SPCMD_FRAMESIZE_BITS;
-				cmd |= BITA;  // 8 bits per transfer
-				rspidrv.SPCMD0.WORD = cmd;
-			}
+			_frame_size(BITA);  // 8 bits per transfer
+			_data_control(0x00);  // Single frame, word access
 			rspidrv.SPDR.WORD.H = (uint16_t)inb;
 			while (rspidrv.SPSR.BIT.IDLNF)
 				;  // Waiting for RSPI to go Idle...
 			return (uint8_t)rspidrv.SPDR.WORD.H;
 		};
 
+		using SPIClass::transfer9;  // Buffer version
+
 		__noinline
 		uint16_t transfer9(uint16_t inw) {
-			uint16_t cmd = rspidrv.SPCMD0.WORD;
-			if ( (cmd & RSPI_SPCMD_FRAMESIZE_BITS) != BITB ) {
-				// SPI currently not set to 9-bit mode; change this
-				cmd &= ~RSPI_SPCMD_FRAMESIZE_BITS;
-				cmd |= BITB;  // 9 bits per transfer
-				rspidrv.SPCMD0.WORD = cmd;
-			}
+			_frame_size(BITB);  // 9 bits per transfer
+			_data_control(0x00);
 			rspidrv.SPDR.WORD.H = (uint16_t)inw;
 			while (rspidrv.SPSR.BIT.IDLNF)
 				;  // Waiting for RSPI to go Idle...
@@ -140,22 +245,98 @@ class RSPI_RX210 : public SPIClass {
 
 		__noinline
 		uint16_t transfer16(uint16_t inw) {
-			uint16_t cmd = rspidrv.SPCMD0.WORD;
-			if ( (cmd & RSPI_SPCMD_FRAMESIZE_BITS) != RSPI_SPCMD_FRAMESIZE_BITS ) {
-				// SPI currently not set to 9-bit mode; change this
-				cmd |= RSPI_SPCMD_FRAMESIZE_BITS;  // 16 bits per transfer
-				rspidrv.SPCMD0.WORD = cmd;
-			}
+			_frame_size(RSPI_SPCMD_FRAMESIZE_BITS);  // 16 bits per transfer
+			_data_control(0x00);
 			rspidrv.SPDR.WORD.H = (uint16_t)inw;
 			while (rspidrv.SPSR.BIT.IDLNF)
 				;  // Waiting for RSPI to go Idle...
 			return (uint16_t)rspidrv.SPDR.WORD.H;
 		};
 
-		bool hasExtendedAPI(void) { return true; };
+		/* Buffer transfers run in multi-frame burst mode: 32-bit frames four at a time, then whatever is
+		 * left over as one burst of 32-bit frames and at most one 16-bit and one 8-bit frame.
+		 */
+		__noinline
+		void transfer(const void *txbuf, void *rxbuf, size_t count) {
+			const uint8_t *tx = (const uint8_t *)txbuf;
+			uint8_t *rx = (uint8_t *)rxbuf;
+			size_t frames = count >> 2;
+
+			if (frames & ~(size_t)3)
+				_burst(tx, rx, frames & ~(size_t)3, 4, 4);
+			if (frames & 3)
+				_burst(tx, rx, frames & 3, 4, frames & 3);
+			if (count & 2)
+				_burst(tx, rx, 1, 2, 1);
+			if (count & 1)
+				_burst(tx, rx, 1, 1, 1);
+		};
+
+		void transfer(void *buf, size_t count) {
+			transfer(buf, buf, count);
+		};
+
+		void write(const void *buf, size_t count) {
+			transfer(buf, NULL, count);
+		};
+
+		boolean hasExtendedAPI(void) { return true; };
+
+		/* Streams exchange one 8-bit frame per SPRI interrupt - the application's SPRIn vector (with its ICU
+		 * IER/IPR set up) calls isr_handle_rx().  Paced streams start each frame from streamTick().
+		 */
+		__noinline
+		boolean beginStream(const void *tx, void *rx, size_t half_size, SPI_STREAM_CALLBACK callback, void *arg = NULL, size_t frame_size = 0) {
+			if (!half_size || (frame_size && half_size % frame_size) || _stream.active())
+				return false;
+
+			_frame_size(BITA);
+			_data_control(0x00);
+			while (rspidrv.SPSR.BIT.IDLNF)
+				;  // Waiting for RSPI to go Idle...
+			_stream.start(tx, rx, half_size, callback, arg, frame_size);
+			rspidrv.SPCR.BIT.SPRIE = 1;
+			if (!_stream.paced())
+				rspidrv.SPDR.WORD.H = _stream.nextTx();
+			return true;
+		};
+
+		// Paced streams - call at the frame rate, e.g. from a timer ISR
+		void streamTick(void) {
+			if (_stream.tick())
+				rspidrv.SPDR.WORD.H = _stream.nextTx();
+		};
+
+		void streamRelease(uint8_t half) { _stream.release(half); };
+
+		__noinline
+		void endStream(void) {
+			rspidrv.SPCR.BIT.SPRIE = 0;
+			_stream.stop();
+			while (rspidrv.SPSR.BIT.IDLNF)
+				;
+			if (rspidrv.SPSR.BIT.SPRF)
+				(void)rspidrv.SPDR.WORD.H;
+		};
+
+		unsigned long streamUnderruns(boolean reset = false) { return _stream.underruns(reset); };
+		unsigned long streamOverruns(boolean reset = false) { return _stream.overruns(reset); };
+
+		// Receive interrupt handler; true = a half was just handed to the application
+		boolean isr_handle_rx(void) {
+			boolean half_done;
+
+			if (!_stream.active())
+				return false;
+			if (_stream.received((uint8_t)rspidrv.SPDR.WORD.H, half_done))
+				rspidrv.SPDR.WORD.H = _stream.nextTx();
+			return half_done;
+		};
 
 		__noinline
-		bool beginTransaction(SPISettings settings) {
+		boolean beginTransaction(const SPISettings & settings) {
+			uint32_t image = _image_of(settings);  // Division only happens the first time these settings are used
+
 			// for atomicity in semaphore check
 			__builtin_rx_clrpsw(8);  // Disable Global Interrupts
 			if (_transaction_semaphore) {
@@ -167,24 +348,37 @@ class RSPI_RX210 : public SPIClass {
 			if (_mask_irq != 255)
 				__builtin_rx_setpsw(8);  // Enable interrupts
 
-			_settings_old.copy(_settings);
+			uint32_t loaded = _settings._image;
+			if (!_transaction_released)
+				_settings_old.copy(_settings);  // Otherwise _settings_old still holds the settings to restore
+			_transaction_released = false;
 			_settings.copy(settings);
-			configClock(_settings._clock);
-			configMode(_settings._bitorder, _settings._datamode);
+			if (image != loaded)
+				_load_image(image);
 			return true;
 		};
 
 		__noinline
 		void endTransaction(void) {
+			uint32_t image = _image_of(_settings_old);  // Keep any division out of the interrupts-off window
 			__builtin_rx_clrpsw(8);  // Disable Global Interrupts
 			_transaction_semaphore = false;
 			// TODO: Unmask gpio IRQ
 
 			// Restore SPI settings under PSW(8)=CLR protection in case an IRQ fires which
 			// uses SPI and expects the default SPISettings to be intact.
+			if (image != _settings._image)
+				_load_image(image);
 			_settings.copy(_settings_old);
-			configClock(_settings._clock);
-			configMode(_settings._bitorder, _settings._datamode);
+			__builtin_rx_setpsw(8);  // Enable interrupts
+		};
+
+		__noinline
+		void releaseTransaction(void) {
+			__builtin_rx_clrpsw(8);  // Disable Global Interrupts
+			_transaction_semaphore = false;
+			_transaction_released = true;
+			// TODO: Unmask gpio IRQ
 			__builtin_rx_setpsw(8);  // Enable interrupts
 		};
 
@@ -10,7 +10,9 @@
 #include <iodefine.h>
 #include <AbstractWiring.h>
 #include <AbstractSerial.h>
+#include <RingBuffer.h>
 #include <RXGPIO.h>
+#include <SCIC_UART_Divisor.h>
 
 #ifndef PCLK_CPU
 // default RX210
@@ -25,75 +27,162 @@ template <
 	>
 class SCIC_UART : public AbstractSerial {
 	private:
-		volatile uint8_t txbuf[tx_buffer_size], rxbuf[rx_buffer_size];
-		volatile size_t tx_head, tx_tail, rx_head, rx_tail;
+		RingBuffer<uint8_t, tx_buffer_size> txbuf;
+		RingBuffer<uint8_t, rx_buffer_size> rxbuf;
 		SERIAL_BREAK_CALLBACK _breakcb;
+		int _frame_delim;
+		volatile unsigned int _frames_in, _frames_out;  // Completed frames, counted by the RX ISR and readFrame()
+		volatile boolean _rx_truncated;  // The RX ISR cut a frame short on a full ring; cleared once readFrame() drained it
+		boolean _rx_skipping;  // RX ISR is dropping the rest of a frame, up to and including its delimiter
+		enum SerialTxPolicy _tx_policy;
+		unsigned long _tx_timeout;
+		unsigned long _tx_dropped;
+#ifdef SERIAL_ENABLE_STATS
+		struct SerialStats _stats;
+#endif
 
 	public:
 		__noinline
 		SCIC_UART() {
-			tx_head = 0;
-			tx_tail = 0;
-			rx_head = 0;
-			rx_tail = 0;
 			_breakcb = NULL;
+			_frame_delim = -1;
+			_frames_in = 0;
+			_frames_out = 0;
+			_rx_truncated = false;
+			_rx_skipping = false;
+			_tx_policy = SERIAL_TX_BLOCK;
+			_tx_timeout = 0;
+			_tx_dropped = 0;
+#ifdef SERIAL_ENABLE_STATS
+			memset(&_stats, 0, sizeof(_stats));
+#endif
 		};
 
+	private:
 		__noinline
-		void begin(unsigned long bitrate) {
+		void _reset(void) {
 			// Init SCI
 			scicdrv.SCR.BYTE = 0x00;
 			scicdrv.SIMR1.BIT.IICM = 0;  // Not I2C mode
 			scicdrv.SPMR.BYTE = 0x00;  // CTS disabled, CKPH=0, CKPOL=0
 			scicdrv.SMR.BYTE = 0x00;  // Async 8-bit, 1 stopbit, no parity, no multiproc, CKS=PCLK/1
 			scicdrv.SCMR.BYTE = 0x00;  // Serial (not SmartCard), LSB-first
-			scicdrv.SEMR.BYTE = BIT4|BIT5;  // 8 base clock cycles per 1-bit, Noise Cancellation on RXD
-			// Set bitrate
-			configClock(bitrate);  // This may modify BRR and SMR.CKS
+			scicdrv.SEMR.BYTE = BIT5;  // Noise Cancellation on RXD; ABCS/BGDM come from the divisor
+		};
+
+		__noinline
+		void _start(void) {
+			txbuf.clear();
+			rxbuf.clear();
+			_frames_out = _frames_in;
+			_rx_truncated = false;
+			_rx_skipping = false;
 			scicdrv.SCR.BYTE = BIT4 | BIT6;  // RX enabled & RXIE enabled - we're now live
 		};
 
+		// Caller must have TE/RE cleared
+		void _setDivisor(uint8_t brr, uint8_t cks, uint8_t abcs, uint8_t bgdm) {
+			scicdrv.SMR.BIT.CKS = cks;
+			scicdrv.SEMR.BIT.ABCS = abcs;
+#if SCIC_HAS_BGDM
+			scicdrv.SEMR.BIT.BGDM = bgdm;
+#else
+			(void)bgdm;
+#endif
+			scicdrv.BRR = brr;
+		};
+
+		/* TX ring is full; apply the overflow policy.  Returns false if the bytes should be dropped instead,
+		 * true once there's room - for SERIAL_TX_DROP_OLDEST, room for up to `need' bytes.  `since' is when
+		 * this write() first found the ring full, so the timeout covers the whole call.
+		 */
+		__noinline
+		boolean _txMakeRoom(size_t need, unsigned long since) {
+			if (_tx_policy == SERIAL_TX_DROP_NEWEST)
+				return false;
+			if (_tx_policy == SERIAL_TX_DROP_OLDEST) {
+				scicdrv.SCR.BIT.TIE = 0;  // The tail belongs to the TX ISR; keep it out while we move it
+				size_t used = txbuf.available();
+				if (need > used)
+					need = used;
+				txbuf.consume(need);
+				_tx_dropped += need;
+				scicdrv.SCR.BYTE |= BIT5 | BIT7;  // Activate TX, TIE
+				return true;
+			}
+
+			// Blocking policies - is the peripheral suspended?
+			if (!scicdrv.SCR.BIT.RE)
+				return false;  // Peripheral not running
+
+			// Are interrupts disabled?
+			uint32_t psw = __builtin_rx_mvfc(0);  // PSW
+			if ( !(psw & 0x00010000) )
+				return false;  // Interrupts not enabled!
+			// NOTE: We do not check to see whether the current PSW Interrupt Priority Level
+			// is too high for the SCI interrupt to occur, since there's no easy, library-portable
+			// way to ascertain what the current Interrupt Priority Level is for the peripheral.
+
+			while (txbuf.isFull()) {
+				if (_tx_policy == SERIAL_TX_BLOCK_TIMEOUT && (millis() - since) >= _tx_timeout)
+					return false;
+			}
+			return true;
+		};
+
+		// Statistics hooks - empty unless SERIAL_ENABLE_STATS is defined
+		void _statsRxDropped(void) {
+#ifdef SERIAL_ENABLE_STATS
+			_stats.rx_dropped++;
+#endif
+		};
+
+		void _statsRxLevel(void) {
+#ifdef SERIAL_ENABLE_STATS
+			unsigned int used = rxbuf.available();
+			if (used > _stats.rx_high_water)
+				_stats.rx_high_water = used;
+#endif
+		};
+
+		void _statsTxLevel(void) {
+#ifdef SERIAL_ENABLE_STATS
+			unsigned int used = txbuf.available();
+			if (used > _stats.tx_high_water)
+				_stats.tx_high_water = used;
+#endif
+		};
+
+	public:
+		__noinline
+		void begin(unsigned long bitrate) {
+			_reset();
+			configClock(bitrate);  // This may modify BRR, SMR.CKS and SEMR.ABCS
+			_start();
+		};
+
+		/* Constant baud rate version, e.g. Serial.begin<115200>() - the BRR/CKS/ABCS search runs at compile time
+		 * (see SCIC_UART_Divisor.h) and fails the build if nothing is within max_error_ppm.  Needs a constant PCLK_CPU.
+		 */
+		template <unsigned long bitrate, uint32_t max_error_ppm = SCIC_DEFAULT_MAX_ERROR_PPM>
+		void begin(void) {
+			typedef SCIC_UART_Divisor<PCLK_CPU, bitrate, max_error_ppm> divisor;
+
+			_reset();
+			_setDivisor(divisor::brr, divisor::cks, divisor::abcs, divisor::bgdm);
+			_start();
+		};
+
 		__noinline
 		void configClock(unsigned long bitrate) {
 			// Requires PCLK_CPU definition
 			uint8_t scr = scicdrv.SCR.BYTE;
+			scic_divisor d = scic_best_divisor(PCLK_CPU, bitrate);
+
+			if (d.error_ppm == 0xFFFFFFFFUL)
+				return;  // Can't find a valid BRR/CKS config; leave the old one in place.
 			scicdrv.SCR.BYTE &= ~(BIT2 | BIT4 | BIT5 | BIT6 | BIT7);
-			scicdrv.SEMR.BIT.ABCS = 1;  // 8 clocks per bit for high bitrates
-
-			int brr;
-			// Attempt #1 - PCLK/1
-			brr = (PCLK_CPU / (16 * bitrate)) - 1; // 2^(2n-1) = 0.5
-			if (brr < 256) {
-				scicdrv.SMR.BIT.CKS = 0;
-				scicdrv.BRR = brr;
-				scicdrv.SCR.BYTE = scr;
-				return;
-			}
-			// Attempt #2 - PCLK/4
-			brr = (PCLK_CPU / (32 * 2 * bitrate)) - 1; // 2^(2n-1) = 2
-			if (brr < 256) {
-				scicdrv.SMR.BIT.CKS = 1;
-				scicdrv.BRR = brr;
-				scicdrv.SCR.BYTE = scr;
-				return;
-			}
-			// Attempt #3 - PCLK/16
-			brr = (PCLK_CPU / (32 * 8 * bitrate)) - 1; // 2^(2n-1) = 8
-			if (brr < 256) {
-				scicdrv.SMR.BIT.CKS = 2;
-				scicdrv.BRR = brr;
-				scicdrv.SCR.BYTE = scr;
-				return;
-			}
-			// Attempt #4 - PCLK/64
-			brr = (PCLK_CPU / (32 * 32 * bitrate)) - 1; // 2^(2n-1) = 32
-			if (brr < 256) {
-				scicdrv.SMR.BIT.CKS = 3;
-				scicdrv.BRR = brr;
-				scicdrv.SCR.BYTE = scr;
-				return;
-			}
-			// Else .... Can't find a valid BRR/CKS config.
+			_setDivisor(d.brr, d.cks, d.abcs, d.bgdm);
 			scicdrv.SCR.BYTE = scr;
 		};
 
@@ -102,75 +191,243 @@ class SCIC_UART : public AbstractSerial {
 			scicdrv.SCR.BYTE = 0x00;  // Disable SCI
 		};
 
-		int available(void) { return (rx_buffer_size + rx_head - rx_tail) % rx_buffer_size; };
-		int peek(void) { if (rx_head == rx_tail) return -1; return rxbuf[rx_tail]; };
-		void flush(void) { while (tx_head != tx_tail); };
+		int available(void) { return rxbuf.available(); };
+		int peek(void) { if (rxbuf.isEmpty()) return -1; return rxbuf.peek(); };
+		void flush(void) { while (!txbuf.isEmpty()); };
+
+		// Bulk RX for Stream::readBytes()/readBytesUntil() - memchr/memcpy over the (at most two) ring spans
+		__noinline
+		size_t readBuffered(uint8_t *buf, size_t len, int terminator = -1) {
+			size_t n = 0, span;
+			const uint8_t *p, *t;
+
+			while (n < len && (span = rxbuf.readSpan(p)) != 0) {
+				boolean found = false;
+				if (span > len - n)
+					span = len - n;
+				if (terminator >= 0 && (t = (const uint8_t *)memchr(p, terminator, span)) != NULL) {
+					span = (t - p) + 1;
+					found = true;
+				}
+				memcpy(buf + n, p, span);
+				rxbuf.consume(span);
+				n += span;
+				if (found)
+					break;
+			}
+			return n;
+		};
 
 		__noinline
 		int read(void) {
-			if (rx_head == rx_tail)
+			if (rxbuf.isEmpty())
 				return -1;
-
-			uint8_t c = rxbuf[rx_tail];
-			rx_tail = (size_t)(rx_tail + 1) % rx_buffer_size;
-			return c;
+			return rxbuf.pop();
 		};
 
 		__noinline
 		size_t write(uint8_t c) {
-			size_t i = (tx_head + 1) % tx_buffer_size;
-
-			// If the output buffer is full, we must wait.
-			if (i == tx_tail) {
-				// What to do next?
-				// First: Is the peripheral suspended?
-				if (!scicdrv.SCR.BIT.RE)
-					return 0;  // Peripheral not running
-
-				// Second, are interrupts disabled?
-				uint32_t psw = __builtin_rx_mvfc(0);  // PSW
-				if ( !(psw & 0x00010000) )
-					return 0;  // Interrupts not enabled!
-				// NOTE: We do not check to see whether the current PSW Interrupt Priority Level
-				// is too high for the SCI interrupt to occur, since there's no easy, library-portable
-				// way to ascertain what the current Interrupt Priority Level is for the peripheral.
-
-				// Else... just wait
-				while (i == tx_tail)
-					;
+			// If the output buffer is full, the TX policy decides whether we wait or drop.
+			if (txbuf.isFull() && !_txMakeRoom(1, millis())) {
+				_tx_dropped++;
+				return 0;
 			}
 
-			txbuf[tx_head] = c;
-			tx_head = i;
+			txbuf.push(c);
 			scicdrv.SCR.BYTE |= BIT5 | BIT7;  // Activate TX, TIE
+			_statsTxLevel();
 			return 1;
 		};
 
+		// Bulk TX - copies into the ring in at most two spans and arms TX/TIE once per fill, only applying
+		// the TX policy for whatever doesn't fit.
+		__noinline
+		size_t write(const uint8_t *buf, size_t len) {
+			size_t n = 0;
+			unsigned int span;
+			uint8_t *p;
+			unsigned long since = 0;
+			boolean waited = false;
+
+			while (1) {
+				while (n < len && (span = txbuf.writeSpan(p)) != 0) {
+					if (span > len - n)
+						span = len - n;
+					memcpy(p, buf + n, span);
+					txbuf.commit(span);
+					n += span;
+				}
+				if (n) {
+					scicdrv.SCR.BYTE |= BIT5 | BIT7;  // Activate TX, TIE
+					_statsTxLevel();
+				}
+				if (n == len)
+					return n;
+
+				// Remainder doesn't fit
+				if (!waited) {
+					since = millis();
+					waited = true;
+				}
+				if (!_txMakeRoom(len - n, since)) {
+					_tx_dropped += len - n;
+					return n;
+				}
+			}
+		};
+
+		int availableForWrite(void) { return txbuf.availableForWrite(); };
+
+		__noinline
+		void setTxPolicy(enum SerialTxPolicy policy, unsigned long timeout_ms = 0) {
+			_tx_policy = policy;
+			_tx_timeout = timeout_ms;
+		};
+
+		__noinline
+		unsigned long txDropped(boolean reset = false) {
+			unsigned long d = _tx_dropped;
+			if (reset)
+				_tx_dropped = 0;
+			return d;
+		};
+
+#ifdef SERIAL_ENABLE_STATS
+		__noinline
+		boolean getStats(struct SerialStats &stats, boolean reset = false) {
+			uint8_t rie_save = scicdrv.SCR.BYTE & BIT6;
+			scicdrv.SCR.BYTE &= ~BIT6;  // RXI/ERI update the counters; keep them out for a consistent snapshot
+			stats = _stats;
+			if (reset)
+				memset(&_stats, 0, sizeof(_stats));
+			scicdrv.SCR.BYTE |= rie_save;
+			stats.tx_dropped = txDropped(reset);
+			return true;
+		};
+#endif
+
 		operator bool() {  // Is the peripheral enabled?
 			if (scicdrv.SCR.BIT.RE)
 				return true;
 			return false;
 		};
 
+		// Zero-copy span API - direct windows into the ring buffers
+		void rxPeekSpan(const uint8_t *&p, size_t &len) { len = rxbuf.readSpan(p); };
+
+		__noinline
+		void rxConsume(size_t n) {
+			size_t avail = rxbuf.available();
+			rxbuf.consume(n < avail ? n : avail);
+		};
+
+		__noinline
+		size_t txReserve(uint8_t *&p, size_t len) {
+			size_t span = txbuf.writeSpan(p);
+			return (span < len ? span : len);
+		};
+
+		__noinline
+		void txCommit(size_t n) {
+			uint8_t *p;
+			size_t span = txbuf.writeSpan(p);  // Never publish more than txReserve() could have handed out
+			if (n > span)
+				n = span;
+			if (!n)
+				return;
+			txbuf.commit(n);
+			scicdrv.SCR.BYTE |= BIT5 | BIT7;  // Activate TX, TIE
+			_statsTxLevel();
+		};
+
 		__noinline
 		void isr_send_char(void) {  // Utility function used by TX ISR
-			if (tx_head == tx_tail) {
+			if (txbuf.isEmpty()) {
 				// All done; disable TX/TIE
 				scicdrv.SCR.BYTE &= ~(BIT5 | BIT7);
+				return;
 			}
-			scicdrv.TDR = txbuf[tx_tail];
-			tx_tail = (tx_tail + 1) % tx_buffer_size;
+			scicdrv.TDR = txbuf.pop();
 		};
 
 		__noinline
-		void isr_get_char(void) {   // Utility function used by RX ISR
+		boolean isr_get_char(void) {   // Utility function used by RX ISR; true = a frame just completed
 			uint8_t c = scicdrv.RDR;
 
-			if (rx_head == rx_tail) {
-				return;
+			if (_rx_truncated || _rx_skipping) {
+				_statsRxDropped();
+				_rx_skipping = (c != _frame_delim);
+				return false;
+			}
+			if (!rxbuf.push(c)) {
+				_statsRxDropped();
+				if (_frame_delim < 0)
+					return false;  // buffer full, the char is ignored
+				/* A frame which fills the ring can never see its delimiter buffered, so count it now as a truncated
+				 * frame and wake the main loop to drain it.  Until readFrame() has, everything is dropped; then
+				 * the rest of the frame in progress is skipped so the next one starts clean.
+				 */
+				_rx_truncated = true;
+				_rx_skipping = (c != _frame_delim);
+				_frames_in++;
+				return true;
 			}
-			rxbuf[rx_head] = c;
-			rx_head = (rx_head + 1) % rx_buffer_size;
+			_statsRxLevel();
+			if (c == _frame_delim) {
+				_frames_in++;
+				return true;
+			}
+			return false;
+		};
+
+		// Framed RX
+		__noinline
+		void setFrameDelimiter(int delim) {
+			_frame_delim = delim;
+			_frames_out = _frames_in;
+			_rx_truncated = false;
+			_rx_skipping = false;
+		};
+
+		unsigned int framesAvailable(void) { return _frames_in - _frames_out; };
+
+		__noinline
+		size_t readFrame(uint8_t *buf, size_t len) {
+			if (_frames_in == _frames_out)
+				return 0;
+			_frames_out++;
+
+			size_t n = readBuffered(buf, len, _frame_delim);
+			if (n && buf[n-1] == _frame_delim)
+				return n - 1;
+			// Frame didn't fit; drop the rest of it along with its delimiter
+			while (!rxbuf.isEmpty())
+				if (rxbuf.pop() == _frame_delim)
+					return n;
+			// Drained without a delimiter - this was the frame the RX ISR cut short, so it may buffer again
+			_rx_truncated = false;
+			return n;
+		};
+
+		/* Utility function used by the ERI (receive error) ISR - counts the error, runs the break check on a
+		 * framing error and clears SSR.ORER/FER/PER, without which the SCI stops receiving.
+		 */
+		__noinline
+		void isr_rx_error(void) {
+			uint8_t ssr = scicdrv.SSR.BYTE;
+
+#ifdef SERIAL_ENABLE_STATS
+			if (ssr & BIT5)
+				_stats.overrun++;
+			if (ssr & BIT4)
+				_stats.framing++;
+			if (ssr & BIT3)
+				_stats.parity++;
+#endif
+			if (ssr & BIT4)
+				isr_check_break();
+			(void)scicdrv.RDR;  // Discard the bad character
+			scicdrv.SSR.BYTE = (ssr & ~(BIT3 | BIT4 | BIT5)) | BIT6 | BIT7;  // b7-b6 must be written as 1
 		};
 
 		__noinline
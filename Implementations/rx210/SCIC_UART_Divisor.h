@@ -0,0 +1,77 @@
+/* SCIC_UART_Divisor - SCIc asynchronous mode bit rate solver (BRR, SMR.CKS, SEMR.ABCS, SEMR.BGDM)
+ *
+ * Per the RX210 hardware manual, async mode divides PCLK by (64 / 2^ABCS / 2^BGDM) * 2^(2*CKS - 1) * (BRR + 1).
+ * Every CKS/ABCS(/BGDM) combination is tried with the two nearest BRR values and the one with the lowest
+ * bit rate error wins; ties keep the setting with more base clocks per bit (better RX sampling margin).
+ * The solver is constexpr, so with a constant baud rate SCIC_UART::begin<baud>() resolves it at compile time;
+ * configClock() runs the same code at runtime, which is cheap on the RX's hardware divider.
+ */
+
+#ifndef SCIC_UART_DIVISOR_H
+#define SCIC_UART_DIVISOR_H
+
+#include <AbstractWiring.h>
+
+// Set to 1 for RX parts whose SEMR has the BGDM (baud rate generator double-speed) bit; the RX210 does not.
+#ifndef SCIC_HAS_BGDM
+#define SCIC_HAS_BGDM 0
+#endif
+
+// Default static_assert threshold for SCIC_UART_Divisor, in parts per million (2%)
+#ifndef SCIC_DEFAULT_MAX_ERROR_PPM
+#define SCIC_DEFAULT_MAX_ERROR_PPM 20000UL
+#endif
+
+struct scic_divisor {
+	uint8_t brr;
+	uint8_t cks;
+	uint8_t abcs;
+	uint8_t bgdm;
+	uint32_t error_ppm;  // |actual/requested - 1|; 0xFFFFFFFF if no valid setting exists
+
+	constexpr scic_divisor(uint8_t n, uint8_t c, uint8_t a, uint8_t b, uint32_t err) : brr(n), cks(c), abcs(a), bgdm(b), error_ppm(err) { };
+};
+
+constexpr uint32_t scic_error_ppm(uint32_t pclk, uint32_t baud, uint32_t divider)
+{
+	return (uint32_t)((((int64_t)pclk - (int64_t)baud * divider) < 0 ? ((int64_t)baud * divider - pclk) : ((int64_t)pclk - (int64_t)baud * divider))
+		* 1000000LL / ((int64_t)baud * divider));
+}
+
+constexpr scic_divisor scic_best_divisor(uint32_t pclk, uint32_t baud, boolean has_bgdm = SCIC_HAS_BGDM)
+{
+	scic_divisor best(0xFF, 3, 0, 0, 0xFFFFFFFFUL);
+
+	for (uint8_t bgdm = 0; bgdm < (has_bgdm ? 2 : 1); bgdm++) {
+		for (uint8_t abcs = 0; abcs < 2; abcs++) {
+			for (uint8_t cks = 0; cks < 4; cks++) {
+				// PCLK cycles per BRR count: 64 / 2^(ABCS+BGDM) * 2^(2*CKS-1)
+				uint32_t unit = (32UL >> (abcs + bgdm)) << (2 * cks);
+				uint32_t q = pclk / (unit * baud);
+
+				for (uint32_t n1 = q; n1 <= q + 1; n1++) {  // n1 = BRR + 1
+					if (n1 < 1 || n1 > 256)
+						continue;
+					uint32_t err = scic_error_ppm(pclk, baud, unit * n1);
+					if (err < best.error_ppm)
+						best = scic_divisor((uint8_t)(n1 - 1), cks, abcs, bgdm, err);
+				}
+			}
+		}
+	}
+	return best;
+}
+
+// Compile-time divisor for a constant PCLK/baud pair; refuses to build if the best error exceeds max_error_ppm
+template <uint32_t pclk, uint32_t baud, uint32_t max_error_ppm = SCIC_DEFAULT_MAX_ERROR_PPM>
+struct SCIC_UART_Divisor {
+	static constexpr uint32_t error_ppm = scic_best_divisor(pclk, baud).error_ppm;
+	static constexpr uint8_t brr = scic_best_divisor(pclk, baud).brr;
+	static constexpr uint8_t cks = scic_best_divisor(pclk, baud).cks;
+	static constexpr uint8_t abcs = scic_best_divisor(pclk, baud).abcs;
+	static constexpr uint8_t bgdm = scic_best_divisor(pclk, baud).bgdm;
+
+	static_assert(error_ppm <= max_error_ppm, "No SCIc BRR/CKS/ABCS setting meets the bit rate error limit for this PCLK/baud rate");
+};
+
+#endif /* SCIC_UART_DIVISOR_H */
@@ -0,0 +1,230 @@
+/*
+ * SoftSPI.h - bit-banged SPI master on any three RXGPIO_PIN<> pins
+ *
+ * Everything about the pins is a template parameter, so each bit compiles to a handful of direct port
+ * writes: the shift loop is unrolled by template recursion (SoftSPI_Shift) and specialized per SPI mode,
+ * bit order and word length.  The mode and bit order given as template parameters get the fast path;
+ * other settings (setDataMode(), setBitOrder(), beginTransaction()) pick one of the other specializations
+ * at run time, once per call or buffer.
+ *
+ * There's no clock generator - SCLK runs as fast as the port writes go, slowed down by half_period_loops
+ * iterations of a delay loop per half period.  SPISettings clock rates are not applied; measureClock()
+ * reports what the bus actually achieves, to check against the device's limit.
+ *
+ * Any type with the static read()/write()/setMode() interface of RXGPIO_PIN works as a pin.
+ */
+
+#ifndef SOFTSPI_H
+#define SOFTSPI_H
+
+#include <AbstractWiring.h>
+#include <SPI.h>
+#include <RXGPIO.h>
+
+template <unsigned int loops>
+__inline void softspi_delay(void) {
+	for (volatile unsigned int i = loops; i; i--)
+		;
+}
+
+template <>
+__inline void softspi_delay<0>(void) { }
+
+/* Shifts bit i of a `bits'-bit word (counting in transmission order) and recurses to bit i+1.
+ * CPHA=0: MOSI set up before the leading SCLK edge, MISO sampled on it.
+ * CPHA=1: MOSI changes on the leading edge, MISO sampled on the trailing edge.
+ */
+template <typename SCK_PIN, typename MOSI_PIN, typename MISO_PIN, uint8_t mode, uint8_t order, unsigned int bits,
+	unsigned int half_period_loops, unsigned int i>
+struct SoftSPI_Shift {
+	static const boolean _cpol = (mode == SPI_MODE2 || mode == SPI_MODE3);
+	static const boolean _cpha = (mode == SPI_MODE1 || mode == SPI_MODE3);
+	static const uint16_t _mask = (order == MSBFIRST) ? (1U << (bits - 1 - i)) : (1U << i);
+
+	__inline static uint16_t run(uint16_t out, uint16_t in) {
+		if (_cpha) {
+			SCK_PIN::write(!_cpol);
+			MOSI_PIN::write((out & _mask) != 0);
+			softspi_delay<half_period_loops>();
+			SCK_PIN::write(_cpol);
+			if (MISO_PIN::read())
+				in |= _mask;
+			softspi_delay<half_period_loops>();
+		} else {
+			MOSI_PIN::write((out & _mask) != 0);
+			softspi_delay<half_period_loops>();
+			SCK_PIN::write(!_cpol);
+			if (MISO_PIN::read())
+				in |= _mask;
+			softspi_delay<half_period_loops>();
+			SCK_PIN::write(_cpol);
+		}
+		return SoftSPI_Shift<SCK_PIN, MOSI_PIN, MISO_PIN, mode, order, bits, half_period_loops, i + 1>::run(out, in);
+	};
+};
+
+template <typename SCK_PIN, typename MOSI_PIN, typename MISO_PIN, uint8_t mode, uint8_t order, unsigned int bits,
+	unsigned int half_period_loops>
+struct SoftSPI_Shift<SCK_PIN, MOSI_PIN, MISO_PIN, mode, order, bits, half_period_loops, bits> {
+	__inline static uint16_t run(uint16_t, uint16_t in) { return in; };
+};
+
+template <
+	typename SCK_PIN,
+	typename MOSI_PIN,
+	typename MISO_PIN,
+	uint8_t datamode = SPI_MODE0,
+	uint8_t bitorder = MSBFIRST,
+	unsigned int half_period_loops = 0
+>
+class SoftSPI : public SPIClass {
+	private:
+		uint8_t _mode, _order;
+		uint8_t _mode_old, _order_old;
+		boolean _transaction_semaphore;
+
+		template <uint8_t mode, uint8_t order, unsigned int bits>
+		__noinline
+		static uint16_t _word(uint16_t out) {
+			return SoftSPI_Shift<SCK_PIN, MOSI_PIN, MISO_PIN, mode, order, bits, half_period_loops, 0>::run(out, 0);
+		};
+
+		template <uint8_t mode, uint8_t order>
+		__noinline
+		static void _buffer(const uint8_t *tx, uint8_t *rx, size_t n) {
+			while (n--) {
+				uint8_t c = (uint8_t)SoftSPI_Shift<SCK_PIN, MOSI_PIN, MISO_PIN, mode, order, 8, half_period_loops, 0>::run(tx != NULL ? *tx++ : 0xFF, 0);
+				if (rx != NULL)
+					*rx++ = c;
+			}
+		};
+
+		// Run-time dispatch to the specialization for the current mode/bit order
+		template <unsigned int bits>
+		uint16_t _transfer(uint16_t out) {
+			if (_mode == datamode && _order == bitorder)
+				return _word<datamode, bitorder, bits>(out);
+			if (_order == MSBFIRST) {
+				switch (_mode) {
+					case SPI_MODE1: return _word<SPI_MODE1, MSBFIRST, bits>(out);
+					case SPI_MODE2: return _word<SPI_MODE2, MSBFIRST, bits>(out);
+					case SPI_MODE3: return _word<SPI_MODE3, MSBFIRST, bits>(out);
+					default: return _word<SPI_MODE0, MSBFIRST, bits>(out);
+				}
+			}
+			switch (_mode) {
+				case SPI_MODE1: return _word<SPI_MODE1, LSBFIRST, bits>(out);
+				case SPI_MODE2: return _word<SPI_MODE2, LSBFIRST, bits>(out);
+				case SPI_MODE3: return _word<SPI_MODE3, LSBFIRST, bits>(out);
+				default: return _word<SPI_MODE0, LSBFIRST, bits>(out);
+			}
+		};
+
+		void _transfer_buffer(const uint8_t *tx, uint8_t *rx, size_t n) {
+			if (_mode == datamode && _order == bitorder) {
+				_buffer<datamode, bitorder>(tx, rx, n);
+				return;
+			}
+			if (_order == MSBFIRST) {
+				switch (_mode) {
+					case SPI_MODE1: _buffer<SPI_MODE1, MSBFIRST>(tx, rx, n); return;
+					case SPI_MODE2: _buffer<SPI_MODE2, MSBFIRST>(tx, rx, n); return;
+					case SPI_MODE3: _buffer<SPI_MODE3, MSBFIRST>(tx, rx, n); return;
+					default: _buffer<SPI_MODE0, MSBFIRST>(tx, rx, n); return;
+				}
+			}
+			switch (_mode) {
+				case SPI_MODE1: _buffer<SPI_MODE1, LSBFIRST>(tx, rx, n); return;
+				case SPI_MODE2: _buffer<SPI_MODE2, LSBFIRST>(tx, rx, n); return;
+				case SPI_MODE3: _buffer<SPI_MODE3, LSBFIRST>(tx, rx, n); return;
+				default: _buffer<SPI_MODE0, LSBFIRST>(tx, rx, n); return;
+			}
+		};
+
+		void _idle_clock(void) {
+			SCK_PIN::write(_mode == SPI_MODE2 || _mode == SPI_MODE3);
+		};
+
+	public:
+		SoftSPI() : _mode(datamode), _order(bitorder), _mode_old(datamode), _order_old(bitorder), _transaction_semaphore(false) { };
+
+		void begin(void) {
+			_idle_clock();
+			MOSI_PIN::write(0);
+			SCK_PIN::setMode(1);
+			MOSI_PIN::setMode(1);
+			MISO_PIN::setMode(0);
+		};
+
+		void end(void) {
+			SCK_PIN::setMode(0);
+			MOSI_PIN::setMode(0);
+		};
+
+		void setBitOrder(unsigned int msblsb) { _order = msblsb; };
+
+		void setDataMode(unsigned int mode) {
+			_mode = mode;
+			_idle_clock();
+		};
+
+		void setClockDivider(int) { };  // SCLK is set by half_period_loops; see measureClock()
+
+		// Data transfer
+		uint8_t transfer(uint8_t inb) { return (uint8_t)_transfer<8>(inb); };
+		uint16_t transfer9(uint16_t inw) { return _transfer<9>(inw); };
+		uint16_t transfer16(uint16_t inw) { return _transfer<16>(inw); };
+		using SPIClass::transfer9;  // Buffer version
+
+		void transfer(void *buf, size_t n) { _transfer_buffer((const uint8_t *)buf, (uint8_t *)buf, n); };
+		void transfer(const void *tx, void *rx, size_t n) { _transfer_buffer((const uint8_t *)tx, (uint8_t *)rx, n); };
+		void write(const void *buf, size_t n) { _transfer_buffer((const uint8_t *)buf, NULL, n); };
+
+		boolean hasExtendedAPI(void) { return true; };
+
+		// Achieved SCLK in Hz, timed over a 64-byte write with micros() in the current mode
+		__noinline
+		uint32_t measureClock(void) {
+			uint8_t dummy[64];
+			unsigned long start, elapsed;
+
+			memset(dummy, 0xFF, sizeof(dummy));
+			start = micros();
+			write(dummy, sizeof(dummy));
+			elapsed = micros() - start;
+			if (elapsed == 0)
+				elapsed = 1;
+			return (uint32_t)((sizeof(dummy) * 8 * 1000000ULL) / elapsed);
+		};
+
+		// Transactions apply the bit order and mode; the clock rate is not (see above)
+		__noinline
+		boolean beginTransaction(const SPISettings & settings) {
+			__builtin_rx_clrpsw(8);  // Disable Global Interrupts
+			if (_transaction_semaphore) {
+				__builtin_rx_setpsw(8);  // Enable interrupts
+				return false;
+			}
+			_transaction_semaphore = true;
+			__builtin_rx_setpsw(8);  // Enable interrupts
+
+			_mode_old = _mode;
+			_order_old = _order;
+			_order = settings._bitorder;
+			setDataMode(settings._datamode);
+			return true;
+		};
+
+		__noinline
+		void endTransaction(void) {
+			__builtin_rx_clrpsw(8);  // Disable Global Interrupts
+			_transaction_semaphore = false;
+			_order = _order_old;
+			setDataMode(_mode_old);
+			__builtin_rx_setpsw(8);  // Enable interrupts
+		};
+
+		void usingInterrupt(int pin) { ; };  // Transactions never mask interrupts; nothing to do
+};
+
+#endif /* SOFTSPI_H */
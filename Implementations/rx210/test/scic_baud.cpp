@@ -0,0 +1,57 @@
+/* SCIC_UART_Divisor regression table - checked entirely at compile time, so building this file is the test:
+ *
+ *   g++ -std=gnu++14 -fsyntax-only -I.. -I../../../AbstractWiring scic_baud.cpp
+ *
+ * Each entry pins the setting the solver picks and its bit rate error (rounded to 0.01%).  Rates no
+ * setting can reach within the default 2% limit must be flagged, so SCIC_UART::begin<baud>() refuses them.
+ */
+
+#include <stdint.h>
+
+// Just enough of AbstractWiring.h for SCIC_UART_Divisor.h
+#define ABSTRACTWIRING_H
+typedef uint8_t boolean;
+
+#include <SCIC_UART_Divisor.h>
+
+#define CHECK_BAUD(pclk, baud, brr_, cks_, abcs_, error_pct_x100) \
+	static_assert(scic_best_divisor(pclk, baud).brr == brr_ && scic_best_divisor(pclk, baud).cks == cks_ \
+		&& scic_best_divisor(pclk, baud).abcs == abcs_ && scic_best_divisor(pclk, baud).bgdm == 0, \
+		"unexpected SCIc setting at " #pclk "/" #baud); \
+	static_assert((scic_best_divisor(pclk, baud).error_ppm + 50) / 100 == error_pct_x100, \
+		"unexpected SCIc bit rate error at " #pclk "/" #baud)
+#define CHECK_BAUD_REJECT(pclk, baud) \
+	static_assert(scic_best_divisor(pclk, baud).error_ppm > SCIC_DEFAULT_MAX_ERROR_PPM, \
+		"SCIc setting unexpectedly within the default error limit at " #pclk "/" #baud)
+
+// PCLK = 50 MHz
+CHECK_BAUD(50000000UL, 1200, 162, 2, 1, 15);
+CHECK_BAUD(50000000UL, 2400, 162, 1, 0, 15);
+CHECK_BAUD(50000000UL, 4800, 162, 1, 1, 15);
+CHECK_BAUD(50000000UL, 9600, 162, 0, 0, 15);
+CHECK_BAUD(50000000UL, 19200, 162, 0, 1, 15);
+CHECK_BAUD(50000000UL, 38400, 80, 0, 1, 47);
+CHECK_BAUD(50000000UL, 57600, 26, 0, 0, 47);
+CHECK_BAUD(50000000UL, 115200, 26, 0, 1, 47);
+CHECK_BAUD(50000000UL, 1000000UL, 2, 0, 1, 417);
+CHECK_BAUD(50000000UL, 921600, 2, 0, 1, 1303);
+CHECK_BAUD_REJECT(50000000UL, 230400);
+CHECK_BAUD_REJECT(50000000UL, 460800);
+CHECK_BAUD_REJECT(50000000UL, 921600);
+CHECK_BAUD_REJECT(50000000UL, 1000000UL);
+
+// PCLK = 32 MHz - ABCS lets 38400 reach 0.16% and 1 Mbaud divide exactly
+CHECK_BAUD(32000000UL, 9600, 103, 0, 0, 16);
+CHECK_BAUD(32000000UL, 38400, 25, 0, 0, 16);
+CHECK_BAUD(32000000UL, 57600, 34, 0, 1, 79);
+CHECK_BAUD(32000000UL, 1000000UL, 0, 0, 0, 0);
+CHECK_BAUD_REJECT(32000000UL, 115200);
+
+// PCLK = 25 MHz
+CHECK_BAUD(25000000UL, 9600, 162, 0, 1, 15);
+CHECK_BAUD(25000000UL, 57600, 26, 0, 1, 47);
+CHECK_BAUD_REJECT(25000000UL, 115200);
+
+// The template refuses to build at the flagged rates; these must build
+static_assert(SCIC_UART_Divisor<50000000UL, 9600>::brr == 162, "SCIC_UART_Divisor disagrees with scic_best_divisor()");
+static_assert(SCIC_UART_Divisor<50000000UL, 115200>::error_ppm < 5000, "SCIC_UART_Divisor disagrees with scic_best_divisor()");
@@ -0,0 +1,150 @@
+/* Host-side bit-level test of SoftSPI.h against fake pins - no RX210 needed:
+ *
+ *   g++ -std=gnu++14 -I.. -I../../../AbstractWiring softspi_host.cpp -o softspi_host && ./softspi_host
+ *
+ * The fake pins stand in for an SPI slave.  They check that MOSI only changes in the half period before the
+ * slave samples it and that MISO is only read in the half period after the master's sampling edge, for all
+ * four modes, both bit orders and 8, 9 and 16-bit words, on the compiled-in fast path and the run-time
+ * dispatched one.
+ */
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdio.h>
+#include <string.h>
+#include <assert.h>
+
+// Just enough of AbstractWiring.h/platform.h and RXGPIO.h for SoftSPI.h and SPI.h
+#define ABSTRACTWIRING_H
+#define RXGPIO_H
+typedef uint8_t boolean;
+#define LSBFIRST 0
+#define MSBFIRST 1
+#define __noinline __attribute__((noinline))
+static inline void __builtin_rx_clrpsw(int) { }
+static inline void __builtin_rx_setpsw(int) { }
+static unsigned long fake_us;
+unsigned long micros(void) { return fake_us += 5; }
+
+#include <SPI.h>
+#include <SoftSPI.h>
+
+static int mode_now;
+static boolean sck, mosi;
+static boolean in_word;  // Between check_word()'s setup and its checks
+static int edges, nsampled, nread;
+static boolean sampled[16], slave_bits[16];
+
+static boolean cpol(void) { return mode_now == SPI_MODE2 || mode_now == SPI_MODE3; }
+static boolean cpha(void) { return mode_now == SPI_MODE1 || mode_now == SPI_MODE3; }
+
+// The slave samples MOSI on the leading edge for CPHA=0, on the trailing edge for CPHA=1
+struct FakeSCK {
+	static void write(boolean v) {
+		if (v != sck) {
+			boolean leading = (v != cpol());
+			if (leading != cpha())
+				sampled[nsampled++] = mosi;
+			edges++;
+		}
+		sck = v;
+	};
+	static boolean read(void) { return sck; };
+	static void setMode(boolean) { };
+};
+
+// MOSI may only change while SCK is at the level before the slave's sampling edge
+struct FakeMOSI {
+	static void write(boolean v) {
+		if (in_word && edges)
+			assert(sck == (cpha() ? !cpol() : cpol()));
+		mosi = v;
+	};
+	static boolean read(void) { return mosi; };
+	static void setMode(boolean) { };
+};
+
+// The master reads MISO right after its own sampling edge: leading for CPHA=0, trailing for CPHA=1
+struct FakeMISO {
+	static void write(boolean) { };
+	static boolean read(void) {
+		assert(sck == (cpha() ? cpol() : !cpol()));
+		assert(edges == 2 * nread + (cpha() ? 2 : 1));
+		return slave_bits[nread++];
+	};
+	static void setMode(boolean) { };
+};
+
+static SoftSPI<FakeSCK, FakeMOSI, FakeMISO> spi;                           // Fast path MODE0, MSB first
+static SoftSPI<FakeSCK, FakeMOSI, FakeMISO, SPI_MODE3, LSBFIRST, 2> spi3;  // Fast path MODE3, LSB first
+
+static unsigned int bit_of(uint16_t w, unsigned int bits, uint8_t order, unsigned int i) {
+	return (w >> ((order == MSBFIRST) ? bits - 1 - i : i)) & 1;
+}
+
+template <class S>
+static void check_word(S & s, uint8_t mode, uint8_t order, unsigned int bits, uint16_t out, uint16_t reply) {
+	uint16_t in;
+	unsigned int i;
+
+	mode_now = mode;
+	assert(s.beginTransaction(SPISettings(1000000UL, order, mode)));
+	assert(sck == cpol());
+	edges = nsampled = nread = 0;
+	for (i = 0; i < bits; i++)
+		slave_bits[i] = bit_of(reply, bits, order, i);
+	in_word = true;
+
+	if (bits == 8)
+		in = s.transfer((uint8_t)out);
+	else if (bits == 9)
+		in = s.transfer9(out);
+	else
+		in = s.transfer16(out);
+	in_word = false;
+
+	assert(edges == 2 * (int)bits && nsampled == (int)bits && nread == (int)bits);
+	assert(sck == cpol());  // Back at idle
+	for (i = 0; i < bits; i++)
+		assert(sampled[i] == bit_of(out, bits, order, i));
+	assert(in == reply);
+	s.endTransaction();
+}
+
+template <class S>
+static void check_all(S & s) {
+	static const unsigned int word_bits[3] = { 8, 9, 16 };
+	static const uint16_t out[3] = { 0xA5, 0x15A, 0xC3A5 }, reply[3] = { 0x3C, 0x0C3, 0x5A0F };
+	uint8_t mode, o, w;
+
+	for (mode = SPI_MODE0; mode <= SPI_MODE3; mode++)
+		for (o = 0; o < 2; o++)
+			for (w = 0; w < 3; w++)
+				check_word(s, mode, o ? LSBFIRST : MSBFIRST, word_bits[w], out[w], reply[w]);
+}
+
+int main()
+{
+	uint8_t buf[2] = { 0xA5, 0x3C };
+	int i;
+
+	mode_now = SPI_MODE0;
+	spi.begin();
+	check_all(spi);
+	mode_now = SPI_MODE3;
+	spi3.begin();
+	check_all(spi3);
+
+	// Buffer path, run-time dispatched: MODE1, LSB first
+	mode_now = SPI_MODE1;
+	assert(spi.beginTransaction(SPISettings(1000000UL, LSBFIRST, SPI_MODE1)));
+	edges = nsampled = nread = 0;
+	for (i = 0; i < 16; i++)
+		slave_bits[i] = i & 1;
+	spi.transfer(buf, 2);  // Two separate words as far as the fake pins go
+	spi.endTransaction();
+	assert(buf[0] == 0xAA && buf[1] == 0xAA);
+
+	printf("SoftSPI: all modes, bit orders and word sizes OK\n");
+	return 0;
+}